@@ -0,0 +1,217 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  adaptiveSampler.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Builds a frequency grid with points concentrated where responses change
+//				 quickly.  Starts from a coarse logarithmic grid and bisects intervals
+//				 whose midpoint differs from the straight line between its neighbors by
+//				 more than the tolerance.  One grid is refined for all responses, so
+//				 their total can be formed on the same grid.
+
+// Local headers
+#include "adaptiveSampler.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//==========================================================================
+// Class:			AdaptiveSampler
+// Function:		AdaptiveSampler
+//
+// Description:		Constructor for AdaptiveSampler class.
+//
+// Input Arguments:
+//		options	= const Options&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AdaptiveSampler::AdaptiveSampler(const Options &options) : options(options)
+{
+}
+
+//==========================================================================
+// Class:			AdaptiveSampler
+// Function:		CreateGrid
+//
+// Description:		Refines a coarse grid until every interval is within
+//					tolerance for every program, or the point budget is used.
+//					Each pass evaluates the midpoints of the intervals being
+//					tested and keeps them; intervals outside the tolerance are
+//					tested again as two halves in the next pass.  When the
+//					budget runs short, the intervals with the largest errors
+//					are tested first.
+//
+// Input Arguments:
+//		minFreq		= const double& [Hz]
+//		maxFreq		= const double& [Hz]
+//		programs	= const std::vector<const CompiledExpression*>&
+//		cancel		= const std::atomic<bool>*, may be nullptr
+//
+// Output Arguments:
+//		workspace	= EvaluationWorkspace&, holds intermediate results
+//
+// Return Value:
+//		std::shared_ptr<const FrequencyGrid>, nullptr if cancelled
+//
+//==========================================================================
+std::shared_ptr<const FrequencyGrid> AdaptiveSampler::CreateGrid(const double &minFreq,
+	const double &maxFreq, const std::vector<const CompiledExpression*> &programs,
+	EvaluationWorkspace &workspace, const std::atomic<bool> *cancel) const
+{
+	const unsigned int initialPoints(std::max(options.initialPoints, 2U));
+	const unsigned int maximumPoints(std::max(options.maximumPoints, initialPoints));
+
+	const FrequencyGrid initialGrid(minFreq, maxFreq, initialPoints);
+	std::vector<double> frequencies(initialGrid.GetFrequencies());
+	std::vector<Samples> samples(programs.size());
+	Evaluate(programs, initialGrid, workspace, samples);
+
+	std::vector<Interval> candidates;
+	for (unsigned int i = 0; i + 1 < frequencies.size(); ++i)
+		candidates.push_back({ i, std::numeric_limits<double>::infinity() });
+
+	std::vector<double> midpoints;
+	std::vector<Samples> midpointSamples(programs.size());
+	std::vector<double> mergedFrequencies;
+	std::vector<Samples> mergedSamples(programs.size());
+	std::vector<Interval> nextCandidates;
+	while (!candidates.empty() && frequencies.size() < maximumPoints)
+	{
+		if (cancel && *cancel)
+			return nullptr;
+
+		const unsigned int budget(maximumPoints - static_cast<unsigned int>(frequencies.size()));
+		if (candidates.size() > budget)
+		{
+			std::nth_element(candidates.begin(), candidates.begin() + budget, candidates.end(),
+				[](const Interval &a, const Interval &b) { return a.error > b.error; });
+			candidates.resize(budget);
+		}
+		std::sort(candidates.begin(), candidates.end(),
+			[](const Interval &a, const Interval &b) { return a.left < b.left; });
+
+		// Midpoints are taken in log frequency, to match the initial spacing
+		midpoints.resize(candidates.size());
+		for (unsigned int i = 0; i < candidates.size(); ++i)
+			midpoints[i] = sqrt(frequencies[candidates[i].left] * frequencies[candidates[i].left + 1]);
+		Evaluate(programs, FrequencyGrid(midpoints), workspace, midpointSamples);
+
+		mergedFrequencies.clear();
+		for (auto& s : mergedSamples)
+			s.clear();
+		nextCandidates.clear();
+
+		unsigned int k(0);
+		for (unsigned int i = 0; i < frequencies.size(); ++i)
+		{
+			mergedFrequencies.push_back(frequencies[i]);
+			for (unsigned int p = 0; p < programs.size(); ++p)
+				mergedSamples[p].push_back(samples[p][i]);
+
+			if (k == candidates.size() || candidates[k].left != i)
+				continue;
+
+			double error(0.0);
+			for (unsigned int p = 0; p < programs.size(); ++p)
+				error = std::max(error, GetError(samples[p][i], midpointSamples[p][k], samples[p][i + 1]));
+
+			const unsigned int middle(static_cast<unsigned int>(mergedFrequencies.size()));
+			mergedFrequencies.push_back(midpoints[k]);
+			for (unsigned int p = 0; p < programs.size(); ++p)
+				mergedSamples[p].push_back(midpointSamples[p][k]);
+
+			// Intervals too narrow to split further are left as they are
+			if (error > 1.0 && midpoints[k] > frequencies[i] && midpoints[k] < frequencies[i + 1])
+			{
+				nextCandidates.push_back({ middle - 1, error });
+				nextCandidates.push_back({ middle, error });
+			}
+			++k;
+		}
+
+		frequencies.swap(mergedFrequencies);
+		samples.swap(mergedSamples);
+		candidates.swap(nextCandidates);
+	}
+
+	return std::make_shared<const FrequencyGrid>(std::move(frequencies));
+}
+
+//==========================================================================
+// Class:			AdaptiveSampler
+// Function:		Evaluate
+//
+// Description:		Evaluates every program at each frequency of the grid.
+//
+// Input Arguments:
+//		programs	= const std::vector<const CompiledExpression*>&
+//		grid		= const FrequencyGrid&
+//		workspace	= EvaluationWorkspace&
+//
+// Output Arguments:
+//		samples		= std::vector<Samples>&, one per program
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void AdaptiveSampler::Evaluate(const std::vector<const CompiledExpression*> &programs,
+	const FrequencyGrid &grid, EvaluationWorkspace &workspace, std::vector<Samples> &samples)
+{
+	for (unsigned int p = 0; p < programs.size(); ++p)
+	{
+		const ComplexVector& response(programs[p]->Evaluate(grid, workspace));
+		samples[p].resize(grid.GetSize());
+		for (unsigned int i = 0; i < grid.GetSize(); ++i)
+			samples[p][i] = std::complex<double>(response.GetReal()[i], response.GetImaginary()[i]);
+	}
+}
+
+//==========================================================================
+// Class:			AdaptiveSampler
+// Function:		GetError
+//
+// Description:		Compares the response at the midpoint of an interval with
+//					the straight line (in log frequency) between its ends.
+//					Phase changes are taken from ratios of the responses, so
+//					wrapping does not affect the result.  Intervals where the
+//					response is zero or not finite give NaN and are not split.
+//
+// Input Arguments:
+//		left	= const std::complex<double>&
+//		middle	= const std::complex<double>&
+//		right	= const std::complex<double>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, the larger of the magnitude and phase errors, each relative to
+//		its tolerance
+//
+//==========================================================================
+double AdaptiveSampler::GetError(const std::complex<double> &left,
+	const std::complex<double> &middle, const std::complex<double> &right) const
+{
+	const double magnitudeError(fabs(20.0 * log10(std::abs(middle))
+		- 10.0 * (log10(std::abs(left)) + log10(std::abs(right)))));// [dB]
+	const double phaseError(fabs(std::arg(middle / left) - std::arg(right / middle))
+		* 90.0 / M_PI);// [deg]
+
+	return std::max(magnitudeError / options.magnitudeTolerance, phaseError / options.phaseTolerance);
+}
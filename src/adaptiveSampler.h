@@ -0,0 +1,69 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  adaptiveSampler.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Builds a frequency grid with points concentrated where responses change
+//				 quickly.  Starts from a coarse logarithmic grid and bisects intervals
+//				 whose midpoint differs from the straight line between its neighbors by
+//				 more than the tolerance.  One grid is refined for all responses, so
+//				 their total can be formed on the same grid.
+
+#ifndef _ADAPTIVE_SAMPLER_H_
+#define _ADAPTIVE_SAMPLER_H_
+
+// Local headers
+#include "compiledExpression.h"
+#include "frequencyGrid.h"
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <complex>
+
+class AdaptiveSampler
+{
+public:
+	struct Options
+	{
+		unsigned int initialPoints = 101;
+		unsigned int maximumPoints = 5000;
+		double magnitudeTolerance = 0.1;// [dB]
+		double phaseTolerance = 1.0;// [deg]
+	};
+
+	explicit AdaptiveSampler(const Options &options);
+
+	// Frequencies are in [Hz].  The workspace is kept by the caller, so its
+	// buffers are reused from one grid to the next.  Returns nullptr if
+	// cancelled.
+	std::shared_ptr<const FrequencyGrid> CreateGrid(const double &minFreq, const double &maxFreq,
+		const std::vector<const CompiledExpression*> &programs, EvaluationWorkspace &workspace,
+		const std::atomic<bool> *cancel = nullptr) const;
+
+private:
+	const Options options;
+
+	typedef std::vector<std::complex<double>> Samples;
+
+	struct Interval
+	{
+		unsigned int left;// Index of the lower frequency
+		double error;// Of the interval this was split from, relative to the tolerance
+	};
+
+	static void Evaluate(const std::vector<const CompiledExpression*> &programs,
+		const FrequencyGrid &grid, EvaluationWorkspace &workspace, std::vector<Samples> &samples);
+	double GetError(const std::complex<double> &left, const std::complex<double> &middle,
+		const std::complex<double> &right) const;
+};
+
+#endif// _ADAPTIVE_SAMPLER_H_
@@ -0,0 +1,221 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  backgroundSolver.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Solves compiled transfer functions on a worker thread.  Each job carries
+//				 a generation number; posting a new job cancels the one in progress, so
+//				 stale work is abandoned instead of queued.
+
+// Local headers
+#include "backgroundSolver.h"
+
+//==========================================================================
+// Class:			BackgroundSolver
+// Function:		~BackgroundSolver
+//
+// Description:		Destructor for BackgroundSolver class.  Cancels any work
+//					in progress and waits for the worker thread to exit.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BackgroundSolver::~BackgroundSolver()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		cancel = true;
+	}
+	jobCondition.notify_one();
+
+	if (worker.joinable())
+		worker.join();
+}
+
+//==========================================================================
+// Class:			BackgroundSolver
+// Function:		Post
+//
+// Description:		Hands a job to the worker thread.  A job that has not
+//					started yet is replaced, and the job in progress is
+//					cancelled.
+//
+// Input Arguments:
+//		job			= Job
+//		onComplete	= std::function<void()>, called from the worker thread
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BackgroundSolver::Post(Job job, std::function<void()> onComplete)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		nextJob = std::move(job);
+		hasJob = true;
+		this->onComplete = std::move(onComplete);
+		cancel = true;
+
+		if (!worker.joinable())
+			worker = std::thread(&BackgroundSolver::ThreadEntry, this);
+	}
+	jobCondition.notify_one();
+}
+
+//==========================================================================
+// Class:			BackgroundSolver
+// Function:		TakeResult
+//
+// Description:		Removes the most recent result.  Results that were never
+//					taken are replaced by newer ones.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<Result>, nullptr if no result is ready
+//
+//==========================================================================
+std::unique_ptr<BackgroundSolver::Result> BackgroundSolver::TakeResult()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return std::move(result);
+}
+
+//==========================================================================
+// Class:			BackgroundSolver
+// Function:		Solve
+//
+// Description:		Solves every program in the job together, so all threads
+//					are kept busy even when each program has few frequencies.
+//					If the job has a sampler, the grid is refined first.
+//					Stops early if the job is cancelled.
+//
+// Input Arguments:
+//		job	= const Job&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<Result>, nullptr if cancelled
+//
+//==========================================================================
+std::unique_ptr<BackgroundSolver::Result> BackgroundSolver::Solve(const Job &job)
+{
+	solver.SetThreadCount(threadCount);
+
+	auto jobResult(std::make_unique<Result>());
+	jobResult->generation = job.generation;
+	jobResult->grid = job.grid;
+	jobResult->programs = job.programs;
+	jobResult->responses.reserve(job.programs.size());
+	jobResult->totalResponses.reserve(job.programs.size());
+
+	std::vector<const CompiledExpression*> programs;
+	programs.reserve(job.programs.size());
+	for (const auto& program : job.programs)
+		programs.push_back(program.get());
+
+	if (job.sampler)
+	{
+		jobResult->grid = job.sampler->CreateGrid(job.grid->GetMinimum(),
+			job.grid->GetMaximum(), programs, samplerWorkspace, &cancel);
+		if (!jobResult->grid)
+			return nullptr;
+	}
+
+	std::vector<ExpressionTree::SolveTask> tasks;
+	tasks.reserve(programs.size());
+	for (unsigned int i = 0; i < programs.size(); ++i)
+	{
+		auto response(std::make_shared<Response>());
+		response->grid = job.grids[i] ? job.grids[i] : jobResult->grid;
+		tasks.push_back({ programs[i], response->grid.get(), &response->magnitude, &response->phase });
+
+		std::shared_ptr<Response> totalResponse(response);
+		if (response->grid != jobResult->grid)
+		{
+			totalResponse = std::make_shared<Response>();
+			totalResponse->grid = jobResult->grid;
+			tasks.push_back({ programs[i], totalResponse->grid.get(),
+				&totalResponse->magnitude, &totalResponse->phase });
+		}
+
+		jobResult->responses.push_back(std::move(response));
+		jobResult->totalResponses.push_back(std::move(totalResponse));
+	}
+
+	solver.Solve(tasks, &cancel);
+	if (cancel)
+		return nullptr;
+
+	return jobResult;
+}
+
+//==========================================================================
+// Class:			BackgroundSolver
+// Function:		ThreadEntry
+//
+// Description:		Entry point for the worker thread.  Waits for jobs and
+//					solves them until the solver is destroyed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BackgroundSolver::ThreadEntry()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		jobCondition.wait(lock, [this]() { return stopping || hasJob; });
+		if (stopping)
+			return;
+
+		const Job job(std::move(nextJob));
+		const std::function<void()> callback(onComplete);
+		hasJob = false;
+		cancel = false;
+
+		lock.unlock();
+		std::unique_ptr<Result> jobResult(Solve(job));
+		lock.lock();
+
+		if (!jobResult)
+			continue;
+
+		result = std::move(jobResult);
+		lock.unlock();
+		callback();
+		lock.lock();
+	}
+}
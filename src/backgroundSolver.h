@@ -0,0 +1,111 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  backgroundSolver.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Solves compiled transfer functions on a worker thread.  Each job carries
+//				 a generation number; posting a new job cancels the one in progress, so
+//				 stale work is abandoned instead of queued.
+
+#ifndef _BACKGROUND_SOLVER_H_
+#define _BACKGROUND_SOLVER_H_
+
+// Local headers
+#include "compiledExpression.h"
+#include "expressionTree.h"
+#include "frequencyGrid.h"
+#include "adaptiveSampler.h"
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class BackgroundSolver
+{
+public:
+	BackgroundSolver() = default;
+	~BackgroundSolver();
+
+	BackgroundSolver(const BackgroundSolver&) = delete;
+	BackgroundSolver& operator=(const BackgroundSolver&) = delete;
+
+	// Only Y data is stored; X data comes from the grid
+	struct Response
+	{
+		std::shared_ptr<const FrequencyGrid> grid;
+		std::vector<double> magnitude;// [dB]
+		std::vector<double> phase;// [deg]
+	};
+
+	// With a sampler, the grid only gives the range, and a new grid is
+	// refined for the programs before they are solved.  Programs with a
+	// grid of their own are also solved on the job's grid, for the total.
+	struct Job
+	{
+		unsigned int generation;
+		std::shared_ptr<const FrequencyGrid> grid;
+		std::shared_ptr<const AdaptiveSampler> sampler;
+		std::vector<std::shared_ptr<const CompiledExpression>> programs;
+		std::vector<std::shared_ptr<const FrequencyGrid>> grids;// Per program; nullptr for the job's grid
+	};
+
+	// Responses are in the same order as the job's programs.  Total responses
+	// are on the result's grid, and are the same as the responses for programs
+	// without a grid of their own.
+	struct Result
+	{
+		unsigned int generation;
+		std::shared_ptr<const FrequencyGrid> grid;
+		std::vector<std::shared_ptr<const CompiledExpression>> programs;
+		std::vector<std::shared_ptr<const Response>> responses;
+		std::vector<std::shared_ptr<const Response>> totalResponses;
+	};
+
+	// Replaces any job that has not started and cancels the one in progress.
+	// The callback is called from the worker thread when a result is ready.
+	void Post(Job job, std::function<void()> onComplete);
+
+	// Returns the most recent result, or nullptr if none is ready
+	std::unique_ptr<Result> TakeResult();
+
+	// Solves on the calling thread; only for use when nothing has been posted
+	std::unique_ptr<Result> Solve(const Job &job);
+
+	// Zero uses one thread per hardware thread
+	void SetThreadCount(const unsigned int &count) { threadCount = count; }
+	unsigned int GetThreadCount() const { return threadCount; }
+
+private:
+	std::thread worker;// Started on first post
+
+	std::mutex mutex;
+	std::condition_variable jobCondition;
+	bool stopping = false;
+
+	bool hasJob = false;
+	Job nextJob;
+	std::function<void()> onComplete;
+	std::unique_ptr<Result> result;
+
+	std::atomic<bool> cancel{ false };
+	std::atomic<unsigned int> threadCount{ 0 };
+
+	ExpressionTree solver;// Only used by one thread at a time
+	EvaluationWorkspace samplerWorkspace;// For refining grids; also one thread at a time
+
+	void ThreadEntry();
+};
+
+#endif// _BACKGROUND_SOLVER_H_
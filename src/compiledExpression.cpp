@@ -0,0 +1,723 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  compiledExpression.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Immutable program produced by ExpressionTree::Compile.  Contains typed
+//				 operations and pre-parsed constants, so it can be evaluated repeatedly
+//				 without any string handling.  Programs that reduce to a ratio of
+//				 polynomials are evaluated with Horner's method instead, and their
+//				 factored form is kept for computing magnitude and phase directly.
+
+// Local headers
+#include "compiledExpression.h"
+#include "expressionGraph.h"
+#include "tfpMath.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		CompiledExpression
+//
+// Description:		Constructor for CompiledExpression class.
+//
+// Input Arguments:
+//		graph	= const ExpressionGraph&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CompiledExpression::CompiledExpression(const ExpressionGraph &graph)
+{
+	AssembleSteps(graph);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		CompiledExpression
+//
+// Description:		Constructor for CompiledExpression class.  The rational
+//					form must be equivalent to the graph.  Roots of the
+//					rational form are found here, so they are only computed
+//					once per expression.
+//
+// Input Arguments:
+//		graph			= const ExpressionGraph&
+//		rationalForm	= RationalFunction
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CompiledExpression::CompiledExpression(const ExpressionGraph &graph, RationalFunction rationalForm)
+	: isRational(true), rationalForm(std::move(rationalForm)), factoredForm(this->rationalForm)
+{
+	AssembleSteps(graph);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AssembleSteps
+//
+// Description:		Translates the graph into steps that operate on workspace
+//					buffers.  Each node is computed once.  A result is
+//					written over one of its operands when that operand is not
+//					needed again; otherwise the operand is copied first.
+//					Slots are returned to a free list after their last use,
+//					so the number of buffers is kept small.  Constants are
+//					stored in the steps that use them.
+//
+// Input Arguments:
+//		graph	= const ExpressionGraph&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::AssembleSteps(const ExpressionGraph &graph)
+{
+	if (graph.IsEmpty())
+		return;
+
+	const std::vector<unsigned int> order(graph.GetEvaluationOrder());
+
+	// Small integer powers of s are loaded from the frequency grid, so they
+	// do not read s
+	auto isCachedPower = [&graph](const ExpressionGraph::Node &node)
+	{
+		if (node.code != OpCode::Power || graph.GetNode(node.first).code != OpCode::PushS ||
+			!graph.GetNode(node.second).IsConstant())
+			return false;
+
+		const double power(graph.GetNode(node.second).value);
+		return ExpressionGraph::IsInteger(power) && power >= 2.0 &&
+			power <= FrequencyGrid::maximumCachedPower;
+	};
+
+	// Number of times each node's value remains to be read
+	std::vector<unsigned int> uses(graph.GetNodeCount(), 0);
+	for (const auto& i : order)
+	{
+		const ExpressionGraph::Node& node(graph.GetNode(i));
+		if (node.code == OpCode::PushConstant || node.code == OpCode::PushS || isCachedPower(node))
+			continue;
+
+		++uses[node.first];
+		if (node.code != OpCode::Negate)
+			++uses[node.second];
+	}
+
+	std::vector<unsigned int> slots(graph.GetNodeCount(), 0);
+	std::vector<unsigned int> freeSlots;
+	auto allocateSlot = [this, &freeSlots]()
+	{
+		if (freeSlots.empty())
+			return slotCount++;
+
+		const unsigned int slot(freeSlots.back());
+		freeSlots.pop_back();
+		return slot;
+	};
+
+	// Returns a slot holding the operand's value that may be overwritten
+	auto takeOperand = [this, &uses, &slots, &allocateSlot](const unsigned int &operand)
+	{
+		if (--uses[operand] == 0)
+			return slots[operand];
+
+		Step copy;
+		copy.code = StepCode::Copy;
+		copy.operation = OpCode::PushS;// Unused
+		copy.destination = allocateSlot();
+		copy.source = slots[operand];
+		copy.value = 0.0;
+		steps.push_back(copy);
+		return copy.destination;
+	};
+
+	for (const auto& i : order)
+	{
+		const ExpressionGraph::Node& node(graph.GetNode(i));
+		if (node.IsConstant())
+		{
+			if (i != graph.GetRoot())
+				continue;
+
+			// Result does not depend on s
+			Step fill;
+			fill.code = StepCode::Fill;
+			fill.operation = node.code;
+			fill.destination = allocateSlot();
+			fill.source = 0;
+			fill.value = node.value;
+			steps.push_back(fill);
+			slots[i] = fill.destination;
+			continue;
+		}
+
+		Step step;
+		step.operation = node.code;
+		step.source = 0;
+		step.value = 0.0;
+
+		if (node.code == OpCode::PushS)
+		{
+			if (uses[i] == 0 && i != graph.GetRoot())
+				continue;
+
+			step.code = StepCode::LoadS;
+			step.destination = allocateSlot();
+		}
+		else if (isCachedPower(node))
+		{
+			step.code = StepCode::LoadSPower;
+			step.value = graph.GetNode(node.second).value;
+			step.destination = allocateSlot();
+		}
+		else if (node.code == OpCode::Negate)
+		{
+			step.code = StepCode::NegateVector;
+			step.destination = takeOperand(node.first);
+		}
+		else if (graph.GetNode(node.second).IsConstant())
+		{
+			step.value = graph.GetNode(node.second).value;
+			if (node.code == OpCode::Power && ExpressionGraph::IsInteger(step.value))
+				step.code = StepCode::IntegerPower;
+			else
+				step.code = StepCode::VectorScalar;
+			step.destination = takeOperand(node.first);
+		}
+		else if (graph.GetNode(node.first).IsConstant())
+		{
+			step.code = StepCode::ScalarVector;
+			step.value = graph.GetNode(node.first).value;
+			step.destination = takeOperand(node.second);
+		}
+		else
+		{
+			unsigned int first(node.first), second(node.second);
+
+			// Work in place on whichever operand is no longer needed
+			if ((node.code == OpCode::Add || node.code == OpCode::Multiply) &&
+				uses[first] > 1 && uses[second] == 1)
+				std::swap(first, second);
+
+			step.code = StepCode::VectorVector;
+			step.destination = takeOperand(first);
+			step.source = slots[second];
+			if (--uses[second] == 0)
+				freeSlots.push_back(slots[second]);
+		}
+
+		steps.push_back(step);
+		slots[i] = step.destination;
+	}
+
+	resultSlot = slots[graph.GetRoot()];
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		Evaluate
+//
+// Description:		Evaluates the program at each frequency of the grid,
+//					using buffers from the specified workspace to hold
+//					intermediate results.  Uses the rational form, if available.
+//					Otherwise the whole program is run over one tile of the
+//					frequencies at a time, so intermediate results stay in
+//					cache and only the response is the full length.
+//
+// Input Arguments:
+//		grid		= const FrequencyGrid&
+//		workspace	= EvaluationWorkspace&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const ComplexVector& containing the response, owned by the workspace
+//		and valid until the workspace is used again
+//
+//==========================================================================
+const ComplexVector& CompiledExpression::Evaluate(
+	const FrequencyGrid &grid, EvaluationWorkspace &workspace) const
+{
+	ComplexVector& response(workspace.GetResponse());
+	response.Resize(grid.GetSize());
+	Evaluate(grid, 0, grid.GetSize(), workspace, response);
+	return response;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		Evaluate
+//
+// Description:		Evaluates the program for the specified range of
+//					frequencies.  Results are written to the same positions in
+//					the response, which must already be large enough.  Each
+//					point is computed independently of the others, so results
+//					do not depend on how the frequencies are divided into
+//					ranges.
+//
+// Input Arguments:
+//		grid		= const FrequencyGrid&
+//		start		= const unsigned int&, first index to evaluate
+//		end			= const unsigned int&, one past the last index to evaluate
+//		workspace	= EvaluationWorkspace&, must not be in use by another thread
+//
+// Output Arguments:
+//		response	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::Evaluate(const FrequencyGrid &grid, const unsigned int &start,
+	const unsigned int &end, EvaluationWorkspace &workspace, ComplexVector &response) const
+{
+	if (isRational)
+	{
+		rationalForm.Evaluate(grid.GetAngularFrequencies(), start, end, response);
+		return;
+	}
+
+	for (unsigned int tileStart = start; tileStart < end; tileStart += EvaluationWorkspace::tileSize)
+	{
+		const unsigned int count(std::min(EvaluationWorkspace::tileSize, end - tileStart));
+		EvaluateTile(grid, tileStart, count, workspace);
+
+		const ComplexVector& result(workspace.GetSlot(resultSlot));
+		std::copy(result.GetReal(), result.GetReal() + count, response.GetReal() + tileStart);
+		std::copy(result.GetImaginary(), result.GetImaginary() + count, response.GetImaginary() + tileStart);
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		EvaluateBode
+//
+// Description:		Evaluates the magnitude and phase at each frequency of the
+//					grid on the calling thread.  Intermediate results are held
+//					by the workspace.
+//
+// Input Arguments:
+//		grid		= const FrequencyGrid&
+//		workspace	= EvaluationWorkspace&, must not be in use by another thread
+//
+// Output Arguments:
+//		magnitude	= std::vector<double>& [dB]
+//		phase		= std::vector<double>& [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::EvaluateBode(const FrequencyGrid &grid,
+	EvaluationWorkspace &workspace, std::vector<double> &magnitude, std::vector<double> &phase) const
+{
+	const unsigned int size(grid.GetSize());
+	magnitude.resize(size);
+	phase.resize(size);
+
+	ComplexVector& response(workspace.GetResponse());
+	if (!IsFactored())
+		response.Resize(size);
+
+	EvaluateBode(grid, 0, size, workspace, response, magnitude, phase);
+	CorrectPhase(phase);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		EvaluateBode
+//
+// Description:		Evaluates the magnitude and phase for the specified range
+//					of frequencies.  When the factored form is available,
+//					magnitude and phase are computed from it directly.
+//					Otherwise the response is evaluated first.  The phase is
+//					not made continuous.
+//
+// Input Arguments:
+//		grid		= const FrequencyGrid&
+//		start		= const unsigned int&, first index to evaluate
+//		end			= const unsigned int&, one past the last index to evaluate
+//		workspace	= EvaluationWorkspace&, must not be in use by another thread
+//
+// Output Arguments:
+//		response	= ComplexVector&
+//		magnitude	= std::vector<double>& [dB]
+//		phase		= std::vector<double>& [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::EvaluateBode(const FrequencyGrid &grid,
+	const unsigned int &start, const unsigned int &end, EvaluationWorkspace &workspace,
+	ComplexVector &response, std::vector<double> &magnitude, std::vector<double> &phase) const
+{
+	if (IsFactored())
+		factoredForm.Evaluate(grid.GetAngularFrequencies(), start, end, magnitude, phase);
+	else
+	{
+		Evaluate(grid, start, end, workspace, response);
+		TFPMath::GetBodeData(response, start, end, magnitude, phase);
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		PrepareWorkspace
+//
+// Description:		Makes room in the workspace for every intermediate result
+//					of a full tile.  Programs evaluated from another form do
+//					not use the workspace's buffers.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		workspace	= EvaluationWorkspace&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::PrepareWorkspace(EvaluationWorkspace &workspace) const
+{
+	if (!isRational)
+		workspace.Prepare(slotCount, EvaluationWorkspace::tileSize);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		CorrectPhase
+//
+// Description:		Makes the phase continuous once every range is evaluated.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		phase	= std::vector<double>& [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::CorrectPhase(std::vector<double> &phase) const
+{
+	if (IsFactored())
+		ZeroPoleGain::AlignPhase(phase);
+	else
+		TFPMath::UnwrapPhase(phase);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		EvaluateTile
+//
+// Description:		Runs every step of the program over one tile of the
+//					frequency grid.  The result is left in the result slot.
+//					Powers of s are loaded from the grid's angular
+//					frequencies instead of being computed again.
+//
+// Input Arguments:
+//		grid		= const FrequencyGrid&
+//		start		= const unsigned int&, index of the first frequency in the tile
+//		size		= const unsigned int& number of frequencies, no more than
+//					  EvaluationWorkspace::tileSize
+//		workspace	= EvaluationWorkspace&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::EvaluateTile(const FrequencyGrid &grid, const unsigned int &start,
+	const unsigned int &size, EvaluationWorkspace &workspace) const
+{
+	workspace.Prepare(slotCount, size);
+
+	for (const auto& step : steps)
+	{
+		ComplexVector& destination(workspace.GetSlot(step.destination));
+		switch (step.code)
+		{
+		case StepCode::LoadS:
+		{
+			const double *omega(grid.GetAngularFrequencies().data() + start);
+			std::fill(destination.GetReal(), destination.GetReal() + size, 0.0);
+			std::copy(omega, omega + size, destination.GetImaginary());
+			break;
+		}
+
+		case StepCode::LoadSPower:
+		{
+			// s^k = j^k * omega^k, so each part is either zero or +/- omega^k
+			const unsigned int power(static_cast<unsigned int>(step.value));
+			const double *omegaPower(grid.GetAngularFrequencyPower(power).data() + start);
+			double *real(destination.GetReal()), *imaginary(destination.GetImaginary());
+			double *nonZero(power % 2 == 0 ? real : imaginary);
+			double *zero(power % 2 == 0 ? imaginary : real);
+			const double sign(power % 4 < 2 ? 1.0 : -1.0);
+
+			std::fill(zero, zero + size, 0.0);
+			for (unsigned int i = 0; i < size; ++i)
+				nonZero[i] = sign * omegaPower[i];
+			break;
+		}
+
+		case StepCode::Fill:
+			std::fill(destination.GetReal(), destination.GetReal() + size, step.value);
+			std::fill(destination.GetImaginary(), destination.GetImaginary() + size, 0.0);
+			break;
+
+		case StepCode::Copy:
+		{
+			const ComplexVector& source(workspace.GetSlot(step.source));
+			std::copy(source.GetReal(), source.GetReal() + size, destination.GetReal());
+			std::copy(source.GetImaginary(), source.GetImaginary() + size, destination.GetImaginary());
+			break;
+		}
+
+		case StepCode::NegateVector:
+			TFPMath::Multiply(destination, -1.0);
+			break;
+
+		case StepCode::VectorVector:
+			ApplyOperation(step.operation, destination, workspace.GetSlot(step.source));
+			break;
+
+		case StepCode::VectorScalar:
+			ApplyOperation(step.operation, destination, step.value);
+			break;
+
+		case StepCode::ScalarVector:
+			ApplyOperation(step.operation, step.value, destination);
+			break;
+
+		case StepCode::IntegerPower:
+			TFPMath::IntegerPower(destination, static_cast<int>(step.value));
+			break;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ApplyOperation
+//
+// Description:		Applies the specified operation to the specified scalars.
+//
+// Input Arguments:
+//		code	= const OpCode& describing the function to apply
+//		first	= const double& (left operand)
+//		second	= const double& (right operand)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double containing the result of the operation
+//
+//==========================================================================
+double CompiledExpression::ApplyOperation(const OpCode &code,
+	const double &first, const double &second)
+{
+	switch (code)
+	{
+	case OpCode::Add:
+		return first + second;
+
+	case OpCode::Subtract:
+		return first - second;
+
+	case OpCode::Multiply:
+		return first * second;
+
+	case OpCode::Divide:
+		return first / second;
+
+	case OpCode::Power:
+		return pow(first, second);
+
+	default:
+		assert(false);
+	}
+
+	return 0.0;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ApplyOperation
+//
+// Description:		Applies the specified operation to the specified vectors.
+//					The result is stored in first.
+//
+// Input Arguments:
+//		code	= const OpCode& describing the function to apply
+//		first	= ComplexVector& (left operand)
+//		second	= const ComplexVector& (right operand)
+//
+// Output Arguments:
+//		first	= ComplexVector& containing the result
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::ApplyOperation(const OpCode &code, ComplexVector &first,
+	const ComplexVector &second)
+{
+	switch (code)
+	{
+	case OpCode::Add:
+		TFPMath::Add(first, second);
+		break;
+
+	case OpCode::Subtract:
+		TFPMath::Subtract(first, second);
+		break;
+
+	case OpCode::Multiply:
+		TFPMath::Multiply(first, second);
+		break;
+
+	case OpCode::Divide:
+		TFPMath::Divide(first, second);
+		break;
+
+	case OpCode::Power:
+		TFPMath::Power(first, second);
+		break;
+
+	default:
+		assert(false);
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ApplyOperation
+//
+// Description:		Applies the specified operation to the specified vector and
+//					scalar.  The scalar is treated as a real-valued complex
+//					number.  The result is stored in first.
+//
+// Input Arguments:
+//		code	= const OpCode& describing the function to apply
+//		first	= ComplexVector& (left operand)
+//		second	= const double& (right operand)
+//
+// Output Arguments:
+//		first	= ComplexVector& containing the result
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::ApplyOperation(const OpCode &code, ComplexVector &first,
+	const double &second)
+{
+	switch (code)
+	{
+	case OpCode::Add:
+		TFPMath::Add(first, second);
+		break;
+
+	case OpCode::Subtract:
+		TFPMath::Subtract(first, second);
+		break;
+
+	case OpCode::Multiply:
+		TFPMath::Multiply(first, second);
+		break;
+
+	case OpCode::Divide:
+		TFPMath::Divide(first, second);
+		break;
+
+	case OpCode::Power:
+		TFPMath::Power(first, second);
+		break;
+
+	default:
+		assert(false);
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ApplyOperation
+//
+// Description:		Applies the specified operation to the specified scalar and
+//					vector.  The scalar is treated as a real-valued complex
+//					number.  The result is stored in second.
+//
+// Input Arguments:
+//		code	= const OpCode& describing the function to apply
+//		first	= const double& (left operand)
+//		second	= ComplexVector& (right operand)
+//
+// Output Arguments:
+//		second	= ComplexVector& containing the result
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::ApplyOperation(const OpCode &code, const double &first,
+	ComplexVector &second)
+{
+	switch (code)
+	{
+	case OpCode::Add:
+		TFPMath::Add(first, second);
+		break;
+
+	case OpCode::Subtract:
+		TFPMath::Subtract(first, second);
+		break;
+
+	case OpCode::Multiply:
+		TFPMath::Multiply(first, second);
+		break;
+
+	case OpCode::Divide:
+		TFPMath::Divide(first, second);
+		break;
+
+	case OpCode::Power:
+		TFPMath::Power(first, second);
+		break;
+
+	default:
+		assert(false);
+	}
+}
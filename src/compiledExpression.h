@@ -0,0 +1,136 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  compiledExpression.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Immutable program produced by ExpressionTree::Compile.  Contains typed
+//				 operations and pre-parsed constants, so it can be evaluated repeatedly
+//				 without any string handling.  Programs that reduce to a ratio of
+//				 polynomials are evaluated with Horner's method instead, and their
+//				 factored form is kept for computing magnitude and phase directly.
+
+#ifndef _COMPILED_EXPRESSION_H_
+#define _COMPILED_EXPRESSION_H_
+
+// Local headers
+#include "rationalFunction.h"
+#include "zeroPoleGain.h"
+#include "evaluationWorkspace.h"
+#include "complexVector.h"
+#include "frequencyGrid.h"
+
+// Standard C++ headers
+#include <vector>
+
+// Local forward declarations
+class ExpressionGraph;
+
+class CompiledExpression
+{
+public:
+	enum class OpCode
+	{
+		PushConstant,
+		PushS,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Power,
+		Negate
+	};
+
+	struct Instruction
+	{
+		Instruction(const OpCode &code, const double &value = 0.0) : code(code), value(value) {}
+
+		OpCode code;
+		double value;// Only used by PushConstant
+	};
+
+	CompiledExpression() = default;
+	explicit CompiledExpression(const ExpressionGraph &graph);
+	CompiledExpression(const ExpressionGraph &graph, RationalFunction rationalForm);
+
+	bool IsEmpty() const { return steps.empty(); }
+
+	bool IsRational() const { return isRational; }
+	const RationalFunction& GetRationalForm() const { return rationalForm; }
+
+	bool IsFactored() const { return factoredForm.IsValid(); }
+	const ZeroPoleGain& GetFactoredForm() const { return factoredForm; }
+
+	const ComplexVector& Evaluate(const FrequencyGrid &grid, EvaluationWorkspace &workspace) const;
+	void Evaluate(const FrequencyGrid &grid, const unsigned int &start,
+		const unsigned int &end, EvaluationWorkspace &workspace, ComplexVector &response) const;
+
+	// Magnitude [dB] and phase [deg].  A program is never modified by
+	// evaluating it, so any number of threads may evaluate the same program
+	// at once, each with its own workspace.
+	void EvaluateBode(const FrequencyGrid &grid, EvaluationWorkspace &workspace,
+		std::vector<double> &magnitude, std::vector<double> &phase) const;
+
+	// Evaluates [start, end) into outputs that are already sized; the phase
+	// must be passed to CorrectPhase() once all ranges are complete.  The
+	// response is only used when the program is not factored.
+	void EvaluateBode(const FrequencyGrid &grid, const unsigned int &start,
+		const unsigned int &end, EvaluationWorkspace &workspace, ComplexVector &response,
+		std::vector<double> &magnitude, std::vector<double> &phase) const;
+	void CorrectPhase(std::vector<double> &phase) const;
+
+	// Sizes the workspace's buffers for this program, so a thread given any
+	// range to evaluate does not need to allocate
+	void PrepareWorkspace(EvaluationWorkspace &workspace) const;
+
+	static double ApplyOperation(const OpCode &code, const double &first, const double &second);
+
+private:
+	bool isRational = false;
+	RationalFunction rationalForm;
+	ZeroPoleGain factoredForm;
+
+	// The expression graph is translated into steps that operate on
+	// workspace buffers (slots).  Constant operands are stored in the step.
+	enum class StepCode
+	{
+		LoadS,
+		LoadSPower,// destination = s ^ value, from the grid
+		Fill,// destination = value
+		Copy,// destination = source
+		NegateVector,
+		VectorVector,// destination = destination op source
+		VectorScalar,// destination = destination op value
+		ScalarVector,// destination = value op destination
+		IntegerPower// destination = destination ^ value
+	};
+
+	struct Step
+	{
+		StepCode code;
+		OpCode operation;
+		unsigned int destination;
+		unsigned int source;
+		double value;
+	};
+
+	std::vector<Step> steps;
+	unsigned int slotCount = 0;
+	unsigned int resultSlot = 0;
+
+	void AssembleSteps(const ExpressionGraph &graph);
+	void EvaluateTile(const FrequencyGrid &grid, const unsigned int &start,
+		const unsigned int &size, EvaluationWorkspace &workspace) const;
+
+	static void ApplyOperation(const OpCode &code, ComplexVector &first, const ComplexVector &second);
+	static void ApplyOperation(const OpCode &code, ComplexVector &first, const double &second);
+	static void ApplyOperation(const OpCode &code, const double &first, ComplexVector &second);
+};
+
+#endif// _COMPILED_EXPRESSION_H_
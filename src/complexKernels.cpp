@@ -0,0 +1,170 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+// File:  complexKernels.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Portable build of the complex arithmetic kernels and selection of the
+//				 best kernels for the running processor.
+
+// Local headers
+#include "complexKernelsImpl.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace
+{
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		CpuSupportsSse2
+//
+// Description:		Checks the running processor for SSE2 support.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool CpuSupportsSse2()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	return true;// Part of the x86-64 baseline
+#elif defined(_MSC_VER) && defined(_M_IX86)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#elif defined(__GNUC__) && defined(__i386__)
+	return __builtin_cpu_supports("sse2");
+#else
+	return false;
+#endif
+}
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		CpuSupportsAvx2
+//
+// Description:		Checks the running processor and operating system for AVX2
+//					support.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool CpuSupportsAvx2()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	// The OS must save the upper halves of the YMM registers
+	__cpuid(info, 1);
+	const bool osxsave((info[2] & (1 << 27)) != 0);
+	const bool avx((info[2] & (1 << 28)) != 0);
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		SelectTable
+//
+// Description:		Chooses the widest kernels supported by both the build and
+//					the running processor.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const ComplexKernels::Table&
+//
+//==========================================================================
+const ComplexKernels::Table& SelectTable()
+{
+	// The processor is checked first, so nothing built for an unsupported
+	// instruction set runs, not even to find its table
+	if (CpuSupportsAvx2() && ComplexKernels::GetAvx2Table())
+		return *ComplexKernels::GetAvx2Table();
+	else if (CpuSupportsSse2() && ComplexKernels::GetSse2Table())
+		return *ComplexKernels::GetSse2Table();
+	return *ComplexKernels::GetScalarTable();
+}
+
+}// namespace
+
+//==========================================================================
+// Namespace:		ComplexKernels
+// Function:		Get
+//
+// Description:		Returns the kernels to use on this processor.  The choice
+//					is made once, on the first call.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Table&
+//
+//==========================================================================
+const ComplexKernels::Table& ComplexKernels::Get()
+{
+	static const Table& table(SelectTable());
+	return table;
+}
+
+//==========================================================================
+// Namespace:		ComplexKernels
+// Function:		GetScalarTable
+//
+// Description:		Returns the portable kernels.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Table*, never nullptr
+//
+//==========================================================================
+const ComplexKernels::Table* ComplexKernels::GetScalarTable()
+{
+	static constexpr Table table(BuildTable<ScalarPacket>("Scalar"));
+	return &table;
+}
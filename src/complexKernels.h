@@ -0,0 +1,62 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  complexKernels.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Tables of element-wise complex arithmetic routines operating on split
+//				 real/imaginary arrays.  One table is built for each supported
+//				 instruction set and the best one available on the running processor is
+//				 selected the first time Get() is called.  All tables use the same
+//				 sequence of operations (and no fused multiply-add), so they produce
+//				 identical results.
+
+#ifndef _COMPLEX_KERNELS_H_
+#define _COMPLEX_KERNELS_H_
+
+namespace ComplexKernels
+{
+	// a = a op b
+	typedef void (*VectorFunction)(double *aReal, double *aImaginary,
+		const double *bReal, const double *bImaginary, const unsigned int &size);
+	// a = a op b (or b op a), where b is real
+	typedef void (*ScalarFunction)(double *aReal, double *aImaginary,
+		const double &b, const unsigned int &size);
+	// a = a ^ power
+	typedef void (*PowerFunction)(double *aReal, double *aImaginary,
+		const unsigned int &power, const unsigned int &size);
+
+	struct Table
+	{
+		const char *name;
+
+		VectorFunction add;
+		VectorFunction subtract;
+		VectorFunction multiply;
+		VectorFunction divide;
+
+		ScalarFunction addScalar;
+		ScalarFunction subtractScalar;
+		ScalarFunction multiplyScalar;
+		ScalarFunction divideScalar;
+		ScalarFunction scalarSubtract;// a = b - a
+		ScalarFunction scalarDivide;// a = b / a
+
+		PowerFunction integerPower;
+	};
+
+	const Table& Get();
+
+	// Returns nullptr if the instruction set was not available at compile time
+	const Table* GetScalarTable();
+	const Table* GetSse2Table();
+	const Table* GetAvx2Table();
+}
+
+#endif// _COMPLEX_KERNELS_H_
@@ -0,0 +1,75 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+// File:  complexKernelsAvx2.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  AVX2 build of the complex arithmetic kernels.  With gcc this file is
+//				 compiled with -mavx2 (see makefile); MSVC allows the intrinsics
+//				 without changing the target architecture.  This file is only called
+//				 after checking that the processor supports AVX2.
+
+// Local headers
+#include "complexKernelsImpl.h"
+
+#if defined(__AVX2__) || (defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64)))
+#define TFP_HAS_AVX2
+#endif
+
+#ifdef TFP_HAS_AVX2
+
+// Standard C++ headers
+#include <immintrin.h>
+
+namespace
+{
+
+struct Avx2Packet
+{
+	typedef __m256d Type;
+	static const unsigned int width = 4;
+
+	static Type Load(const double *p) { return _mm256_loadu_pd(p); }
+	static void Store(double *p, const Type &v) { _mm256_storeu_pd(p, v); }
+	static Type Set(const double &v) { return _mm256_set1_pd(v); }
+
+	static Type Add(const Type &a, const Type &b) { return _mm256_add_pd(a, b); }
+	static Type Subtract(const Type &a, const Type &b) { return _mm256_sub_pd(a, b); }
+	static Type Multiply(const Type &a, const Type &b) { return _mm256_mul_pd(a, b); }
+	static Type Divide(const Type &a, const Type &b) { return _mm256_div_pd(a, b); }
+};
+
+}// namespace
+
+#endif// TFP_HAS_AVX2
+
+//==========================================================================
+// Namespace:		ComplexKernels
+// Function:		GetAvx2Table
+//
+// Description:		Returns the AVX2 kernels.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Table*, nullptr if AVX2 was not available at compile time
+//
+//==========================================================================
+const ComplexKernels::Table* ComplexKernels::GetAvx2Table()
+{
+#ifdef TFP_HAS_AVX2
+	static constexpr Table table(BuildTable<Avx2Packet>("AVX2"));
+	return &table;
+#else
+	return nullptr;
+#endif
+}
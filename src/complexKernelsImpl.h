@@ -0,0 +1,252 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+// File:  complexKernelsImpl.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Element-wise complex arithmetic written once in terms of a packet type
+//				 that wraps a set of SIMD intrinsics.  Each instruction set is compiled
+//				 in its own translation unit, which includes this file and calls
+//				 BuildTable() with its packet type.  Everything here has internal
+//				 linkage, so code built for one instruction set can never be shared
+//				 with another translation unit by the linker.  Only headers without
+//				 inline library code should be included alongside this file.
+
+#ifndef _COMPLEX_KERNELS_IMPL_H_
+#define _COMPLEX_KERNELS_IMPL_H_
+
+// Local headers
+#include "complexKernels.h"
+
+namespace ComplexKernels
+{
+namespace
+{
+
+// Used for the elements that do not fill a complete packet
+struct ScalarPacket
+{
+	typedef double Type;
+	static const unsigned int width = 1;
+
+	static Type Load(const double *p) { return *p; }
+	static void Store(double *p, const Type &v) { *p = v; }
+	static Type Set(const double &v) { return v; }
+
+	static Type Add(const Type &a, const Type &b) { return a + b; }
+	static Type Subtract(const Type &a, const Type &b) { return a - b; }
+	static Type Multiply(const Type &a, const Type &b) { return a * b; }
+	static Type Divide(const Type &a, const Type &b) { return a / b; }
+};
+
+// Operations between two complex values.  The result is written to (ar, ai).
+struct AddOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai,
+		const typename P::Type &br, const typename P::Type &bi)
+	{
+		ar = P::Add(ar, br);
+		ai = P::Add(ai, bi);
+	}
+};
+
+struct SubtractOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai,
+		const typename P::Type &br, const typename P::Type &bi)
+	{
+		ar = P::Subtract(ar, br);
+		ai = P::Subtract(ai, bi);
+	}
+};
+
+struct MultiplyOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai,
+		const typename P::Type &br, const typename P::Type &bi)
+	{
+		const typename P::Type real(P::Subtract(P::Multiply(ar, br), P::Multiply(ai, bi)));
+		ai = P::Add(P::Multiply(ar, bi), P::Multiply(ai, br));
+		ar = real;
+	}
+};
+
+struct DivideOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai,
+		const typename P::Type &br, const typename P::Type &bi)
+	{
+		// One division per element; the reciprocal is applied to both parts
+		const typename P::Type scale(P::Divide(P::Set(1.0),
+			P::Add(P::Multiply(br, br), P::Multiply(bi, bi))));
+		const typename P::Type real(P::Multiply(P::Add(P::Multiply(ar, br), P::Multiply(ai, bi)), scale));
+		ai = P::Multiply(P::Subtract(P::Multiply(ai, br), P::Multiply(ar, bi)), scale);
+		ar = real;
+	}
+};
+
+// Operations between a complex value and a real value b
+struct AddScalarOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &, const typename P::Type &b)
+	{
+		ar = P::Add(ar, b);
+	}
+};
+
+struct SubtractScalarOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &, const typename P::Type &b)
+	{
+		ar = P::Subtract(ar, b);
+	}
+};
+
+struct MultiplyScalarOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai, const typename P::Type &b)
+	{
+		ar = P::Multiply(ar, b);
+		ai = P::Multiply(ai, b);
+	}
+};
+
+struct DivideScalarOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai, const typename P::Type &b)
+	{
+		ar = P::Divide(ar, b);
+		ai = P::Divide(ai, b);
+	}
+};
+
+struct ScalarSubtractOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai, const typename P::Type &b)
+	{
+		ar = P::Subtract(b, ar);
+		ai = P::Subtract(P::Set(0.0), ai);
+	}
+};
+
+struct ScalarDivideOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai, const typename P::Type &b)
+	{
+		const typename P::Type scale(P::Divide(b, P::Add(P::Multiply(ar, ar), P::Multiply(ai, ai))));
+		ar = P::Multiply(ar, scale);
+		ai = P::Subtract(P::Set(0.0), P::Multiply(ai, scale));
+	}
+};
+
+// Exponentiation by squaring; every element uses the same sequence of products
+struct IntegerPowerOperation
+{
+	template<typename P>
+	static void Apply(typename P::Type &ar, typename P::Type &ai, unsigned int power)
+	{
+		typename P::Type resultReal(P::Set(1.0)), resultImaginary(P::Set(0.0));
+		while (power > 0)
+		{
+			if (power & 1)
+				MultiplyOperation::Apply<P>(resultReal, resultImaginary, ar, ai);
+
+			power >>= 1;
+			if (power > 0)
+				MultiplyOperation::Apply<P>(ar, ai, ar, ai);
+		}
+
+		ar = resultReal;
+		ai = resultImaginary;
+	}
+};
+
+template<typename P, typename Operation>
+void ApplyVector(double *aReal, double *aImaginary, const double *bReal,
+	const double *bImaginary, const unsigned int &size)
+{
+	unsigned int i(0);
+	for (; i + P::width <= size; i += P::width)
+	{
+		typename P::Type ar(P::Load(aReal + i)), ai(P::Load(aImaginary + i));
+		Operation::template Apply<P>(ar, ai, P::Load(bReal + i), P::Load(bImaginary + i));
+		P::Store(aReal + i, ar);
+		P::Store(aImaginary + i, ai);
+	}
+
+	for (; i < size; ++i)
+		Operation::template Apply<ScalarPacket>(aReal[i], aImaginary[i], bReal[i], bImaginary[i]);
+}
+
+template<typename P, typename Operation>
+void ApplyScalar(double *aReal, double *aImaginary, const double &b, const unsigned int &size)
+{
+	const typename P::Type packedB(P::Set(b));
+	unsigned int i(0);
+	for (; i + P::width <= size; i += P::width)
+	{
+		typename P::Type ar(P::Load(aReal + i)), ai(P::Load(aImaginary + i));
+		Operation::template Apply<P>(ar, ai, packedB);
+		P::Store(aReal + i, ar);
+		P::Store(aImaginary + i, ai);
+	}
+
+	for (; i < size; ++i)
+		Operation::template Apply<ScalarPacket>(aReal[i], aImaginary[i], b);
+}
+
+template<typename P>
+void ApplyIntegerPower(double *aReal, double *aImaginary, const unsigned int &power,
+	const unsigned int &size)
+{
+	unsigned int i(0);
+	for (; i + P::width <= size; i += P::width)
+	{
+		typename P::Type ar(P::Load(aReal + i)), ai(P::Load(aImaginary + i));
+		IntegerPowerOperation::Apply<P>(ar, ai, power);
+		P::Store(aReal + i, ar);
+		P::Store(aImaginary + i, ai);
+	}
+
+	for (; i < size; ++i)
+		IntegerPowerOperation::Apply<ScalarPacket>(aReal[i], aImaginary[i], power);
+}
+
+// A constant expression, so tables are constant-initialized data and taking
+// their address runs no code built for the packet's instruction set
+template<typename P>
+constexpr Table BuildTable(const char *name)
+{
+	return Table{name,
+		&ApplyVector<P, AddOperation>,
+		&ApplyVector<P, SubtractOperation>,
+		&ApplyVector<P, MultiplyOperation>,
+		&ApplyVector<P, DivideOperation>,
+		&ApplyScalar<P, AddScalarOperation>,
+		&ApplyScalar<P, SubtractScalarOperation>,
+		&ApplyScalar<P, MultiplyScalarOperation>,
+		&ApplyScalar<P, DivideScalarOperation>,
+		&ApplyScalar<P, ScalarSubtractOperation>,
+		&ApplyScalar<P, ScalarDivideOperation>,
+		&ApplyIntegerPower<P>};
+}
+
+}// namespace
+}// namespace ComplexKernels
+
+#endif// _COMPLEX_KERNELS_IMPL_H_
@@ -0,0 +1,72 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+// File:  complexKernelsSse2.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  SSE2 build of the complex arithmetic kernels.
+
+// Local headers
+#include "complexKernelsImpl.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TFP_HAS_SSE2
+#endif
+
+#ifdef TFP_HAS_SSE2
+
+// Standard C++ headers
+#include <emmintrin.h>
+
+namespace
+{
+
+struct Sse2Packet
+{
+	typedef __m128d Type;
+	static const unsigned int width = 2;
+
+	static Type Load(const double *p) { return _mm_loadu_pd(p); }
+	static void Store(double *p, const Type &v) { _mm_storeu_pd(p, v); }
+	static Type Set(const double &v) { return _mm_set1_pd(v); }
+
+	static Type Add(const Type &a, const Type &b) { return _mm_add_pd(a, b); }
+	static Type Subtract(const Type &a, const Type &b) { return _mm_sub_pd(a, b); }
+	static Type Multiply(const Type &a, const Type &b) { return _mm_mul_pd(a, b); }
+	static Type Divide(const Type &a, const Type &b) { return _mm_div_pd(a, b); }
+};
+
+}// namespace
+
+#endif// TFP_HAS_SSE2
+
+//==========================================================================
+// Namespace:		ComplexKernels
+// Function:		GetSse2Table
+//
+// Description:		Returns the SSE2 kernels.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Table*, nullptr if SSE2 was not available at compile time
+//
+//==========================================================================
+const ComplexKernels::Table* ComplexKernels::GetSse2Table()
+{
+#ifdef TFP_HAS_SSE2
+	static constexpr Table table(BuildTable<Sse2Packet>("SSE2"));
+	return &table;
+#else
+	return nullptr;
+#endif
+}
@@ -0,0 +1,84 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  complexVector.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Vector of complex numbers stored as separate real and imaginary arrays,
+//				 so arithmetic on many points can be done with packed SIMD instructions.
+
+// Local headers
+#include "complexVector.h"
+
+//==========================================================================
+// Class:			ComplexVector
+// Function:		ComplexVector
+//
+// Description:		Constructor for ComplexVector class.  Elements are
+//					initialized to zero.
+//
+// Input Arguments:
+//		size	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ComplexVector::ComplexVector(const unsigned int &size) : real(size), imaginary(size)
+{
+}
+
+//==========================================================================
+// Class:			ComplexVector
+// Function:		Resize
+//
+// Description:		Changes the number of elements.  Existing capacity is
+//					reused.
+//
+// Input Arguments:
+//		size	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ComplexVector::Resize(const unsigned int &size)
+{
+	real.resize(size);
+	imaginary.resize(size);
+}
+
+//==========================================================================
+// Class:			ComplexVector
+// Function:		SetValue
+//
+// Description:		Sets the value of the specified element.
+//
+// Input Arguments:
+//		i		= const unsigned int&
+//		value	= const LibPlot2D::Complex&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ComplexVector::SetValue(const unsigned int &i, const LibPlot2D::Complex &value)
+{
+	real[i] = value.mReal;
+	imaginary[i] = value.mImaginary;
+}
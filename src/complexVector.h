@@ -0,0 +1,48 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  complexVector.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Vector of complex numbers stored as separate real and imaginary arrays,
+//				 so arithmetic on many points can be done with packed SIMD instructions.
+
+#ifndef _COMPLEX_VECTOR_H_
+#define _COMPLEX_VECTOR_H_
+
+// LibPlot2D headers
+#include <lp2d/utilities/math/complex.h>
+
+// Standard C++ headers
+#include <vector>
+
+class ComplexVector
+{
+public:
+	ComplexVector() = default;
+	explicit ComplexVector(const unsigned int &size);
+
+	void Resize(const unsigned int &size);
+	unsigned int GetSize() const { return static_cast<unsigned int>(real.size()); }
+	bool IsEmpty() const { return real.empty(); }
+
+	double* GetReal() { return real.data(); }
+	const double* GetReal() const { return real.data(); }
+	double* GetImaginary() { return imaginary.data(); }
+	const double* GetImaginary() const { return imaginary.data(); }
+
+	LibPlot2D::Complex GetValue(const unsigned int &i) const { return LibPlot2D::Complex(real[i], imaginary[i]); }
+	void SetValue(const unsigned int &i, const LibPlot2D::Complex &value);
+
+private:
+	std::vector<double> real;
+	std::vector<double> imaginary;
+};
+
+#endif// _COMPLEX_VECTOR_H_
@@ -0,0 +1,228 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  curveDecimator.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Reduces curves to the points that can affect their appearance on a
+//				 logarithmic X axis.  Each pixel column keeps its first, last, minimum
+//				 and maximum points, so the drawn curve is unchanged while the number
+//				 of points is bounded by the width of the plot.
+
+// Local headers
+#include "curveDecimator.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+//==========================================================================
+// Class:			CurveDecimator
+// Function:		CurveDecimator
+//
+// Description:		Constructor for CurveDecimator class.  Column edges are
+//					found once here, so points are assigned to columns by
+//					comparison alone.
+//
+// Input Arguments:
+//		xMin	= const double&, left edge of the visible range
+//		xMax	= const double&, right edge of the visible range
+//		columns	= const unsigned int&, width of the visible range [pixels]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CurveDecimator::CurveDecimator(const double &xMin, const double &xMax,
+	const unsigned int &columns) : columns(columns)
+{
+	const double logMin(log10(xMin));
+	const double logMax(log10(xMax));
+	if (!std::isfinite(logMin) || !std::isfinite(logMax) || logMin >= logMax || columns == 0)
+		return;
+
+	edges.resize(columns + 1);
+	edges.front() = xMin;
+	for (unsigned int i = 1; i < columns; ++i)
+		edges[i] = pow(10.0, logMin + (logMax - logMin) * i / columns);
+	edges.back() = xMax;
+}
+
+//==========================================================================
+// Class:			CurveDecimator
+// Function:		GetKeptPoints
+//
+// Description:		Finds the first, last, minimum and maximum points of each
+//					column.  The points to either side of the visible range
+//					are treated as one column each, so the extents of the
+//					data are kept for scaling and lines into the visible range
+//					are unchanged.
+//
+// Input Arguments:
+//		curve	= const Curve&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<unsigned int>, empty if the curve cannot be reduced
+//
+//==========================================================================
+std::vector<unsigned int> CurveDecimator::GetKeptPoints(const Curve &curve) const
+{
+	std::vector<unsigned int> points;
+	unsigned int count(0);
+	for (const auto& span : curve.spans)
+		count += span.size;
+	if (edges.empty() || count <= 4 * (columns + 2))
+		return points;
+
+	points.reserve(4 * (columns + 2));
+
+	int column(-1);
+	Column current{ column, 0, 0, 0, 0 };
+	double minimum(0.0), maximum(0.0);
+	unsigned int index(0);
+	for (const auto& span : curve.spans)
+	{
+		for (unsigned int i = 0; i < span.size; ++i, ++index)
+		{
+			Advance(span.x[i] * curve.xScale, column);
+			const double y(span.y[i] + span.yOffset);
+			if (index == 0 || column != current.column)
+			{
+				if (index > 0)
+					AddPoints(current, points);
+				current = { column, index, index, index, index };
+				minimum = y;
+				maximum = y;
+				continue;
+			}
+
+			current.last = index;
+			if (y < minimum)
+			{
+				current.minimum = index;
+				minimum = y;
+			}
+			else if (y > maximum)
+			{
+				current.maximum = index;
+				maximum = y;
+			}
+		}
+	}
+	AddPoints(current, points);
+
+	return points;
+}
+
+//==========================================================================
+// Class:			CurveDecimator
+// Function:		Extract
+//
+// Description:		Creates a copy of the specified points of the curve, in
+//					the plot's units.
+//
+// Input Arguments:
+//		curve	= const Curve&
+//		points	= const std::vector<unsigned int>&, from GetKeptPoints()
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> CurveDecimator::Extract(const Curve &curve,
+	const std::vector<unsigned int> &points)
+{
+	unsigned int count(static_cast<unsigned int>(points.size()));
+	if (points.empty())
+	{
+		for (const auto& span : curve.spans)
+			count += span.size;
+	}
+
+	auto extracted(std::make_unique<LibPlot2D::Dataset2D>(count));
+	unsigned int span(0), start(0);// Index of the first point in span
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int index(points.empty() ? i : points[i]);
+		while (index >= start + curve.spans[span].size)
+			start += curve.spans[span++].size;
+
+		extracted->GetX()[i] = curve.spans[span].x[index - start] * curve.xScale;
+		extracted->GetY()[i] = curve.spans[span].y[index - start] + curve.spans[span].yOffset;
+	}
+
+	return extracted;
+}
+
+//==========================================================================
+// Class:			CurveDecimator
+// Function:		Advance
+//
+// Description:		Moves to the column containing the specified X value.
+//					X data is increasing, so columns are only ever passed
+//					from left to right.
+//
+// Input Arguments:
+//		x		= const double&
+//
+// Output Arguments:
+//		column	= int&, -1 left of the visible range and columns right of it
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveDecimator::Advance(const double &x, int &column) const
+{
+	const int lastColumn(static_cast<int>(columns) - 1);
+	while (column < lastColumn && x >= edges[column + 1])
+		++column;
+
+	if (column == lastColumn && x > edges.back())
+		column = static_cast<int>(columns);
+}
+
+//==========================================================================
+// Class:			CurveDecimator
+// Function:		AddPoints
+//
+// Description:		Appends the points kept for one column, in their original
+//					order and without duplicates.
+//
+// Input Arguments:
+//		column	= const Column&
+//
+// Output Arguments:
+//		points	= std::vector<unsigned int>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CurveDecimator::AddPoints(const Column &column, std::vector<unsigned int> &points)
+{
+	unsigned int indices[] = { column.first, column.minimum, column.maximum, column.last };
+	std::sort(indices, indices + 4);
+
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		if (i > 0 && indices[i] == indices[i - 1])
+			continue;
+		points.push_back(indices[i]);
+	}
+}
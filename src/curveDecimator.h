@@ -0,0 +1,78 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  curveDecimator.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Reduces curves to the points that can affect their appearance on a
+//				 logarithmic X axis.  Each pixel column keeps its first, last, minimum
+//				 and maximum points, so the drawn curve is unchanged while the number
+//				 of points is bounded by the width of the plot.
+
+#ifndef _CURVE_DECIMATOR_H_
+#define _CURVE_DECIMATOR_H_
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+
+class CurveDecimator
+{
+public:
+	// The visible range is in the plot's X units and must be positive
+	CurveDecimator(const double &xMin, const double &xMax, const unsigned int &columns);
+
+	// Consecutive X and Y data, read in place; Y is shifted by the offset
+	struct Span
+	{
+		const double *x;
+		const double *y;
+		unsigned int size;
+		double yOffset;
+	};
+
+	// A curve made of spans, in order of increasing X, which is scaled into
+	// the plot's units as it is read.  The data must outlive the curve.
+	struct Curve
+	{
+		std::vector<Span> spans;
+		double xScale;
+	};
+
+	// Indices of the points kept for the visible range, in order; empty when
+	// every point is kept.  Comparing these shows whether a curve needs to
+	// be copied into the plot again for a new view.
+	std::vector<unsigned int> GetKeptPoints(const Curve &curve) const;
+
+	// Copies the specified points (or all points, if none are specified)
+	static std::unique_ptr<LibPlot2D::Dataset2D> Extract(const Curve &curve,
+		const std::vector<unsigned int> &points);
+
+private:
+	const unsigned int columns;
+	std::vector<double> edges;// Of each column, in X; empty for an invalid range
+
+	void Advance(const double &x, int &column) const;
+
+	struct Column
+	{
+		int column;
+		unsigned int first;
+		unsigned int last;
+		unsigned int minimum;
+		unsigned int maximum;
+	};
+
+	static void AddPoints(const Column &column, std::vector<unsigned int> &points);
+};
+
+#endif// _CURVE_DECIMATOR_H_
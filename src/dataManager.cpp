@@ -16,87 +16,446 @@
 
 // Local headers
 #include "dataManager.h"
-#include "expressionTree.h"
+#include "zeroPoleGain.h"
 
 // LibPlot2D headers
 #include <lp2d/utilities/math/plotMath.h>
 
-const unsigned int DataManager::numberOfPoints(5000);
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+const unsigned int DataManager::defaultResolution(5000);
+const std::size_t DataManager::defaultMemoryLimit(2000000000);
 
 DataManager::DataManager()
 {
 	frequencyHertz = true;
-	minFreq = 0.01;
-	maxFreq = 100.0;
+	resolution = defaultResolution;
+	memoryLimit = defaultMemoryLimit;
+	grid = GetGrid(0.01, 100.0, resolution);
+	targetGrid = grid;
+	adaptiveSampling = false;
+	samplingOptions.maximumPoints = resolution;
+	totalNeedsUpdate = false;
+	generation = 0;
+	zoomTotalNeedsUpdate = false;
+	zoomGeneration = 0;
 }
 
 bool DataManager::AddTransferFunction(const wxString &numerator, const wxString &denominator)
 {
-	amplitudePlots.Add(std::make_unique<LibPlot2D::Dataset2D>(numberOfPoints));
-	phasePlots.Add(std::make_unique<LibPlot2D::Dataset2D>(numberOfPoints));
+	auto program(std::make_shared<CompiledExpression>());
+	const wxString errorString(CompileTransferFunction(numerator, denominator, *program));
+	if (!errorString.IsEmpty())
+	{
+		wxMessageBox(errorString);
+		return false;
+	}
 
+	std::vector<unsigned int> newResolutions(resolutions);
+	newResolutions.push_back(0);
+	if (!CheckMemory(EstimateMemory(resolution, newResolutions, adaptiveSampling)))
+		return false;
+
+	responses.push_back(nullptr);
+	totalResponses.push_back(nullptr);
+	zoomResponses.push_back(nullptr);
+	zoomPrograms.push_back(nullptr);
 	transferFunctions.push_back(std::make_pair(numerator, denominator));
-	return UpdateTransferFunction(amplitudePlots.GetCount() - 1, numerator, denominator);
+	programs.push_back(std::move(program));
+	pending.push_back(true);
+	resolutions.push_back(0);
+	totalSlots.push_back(totalTree.Insert());
+
+	StartSolve();
+	StartZoomSolve();
+
+	return true;
 }
 
 bool DataManager::UpdateTransferFunction(const unsigned int &i, const wxString &numerator, const wxString &denominator)
 {
-	LibPlot2D::Dataset2D magnitude;
-	LibPlot2D::Dataset2D phase;
+	auto program(std::make_shared<CompiledExpression>());
+	const wxString errorString(CompileTransferFunction(numerator, denominator, *program));
+	if (!errorString.IsEmpty())
+	{
+		wxMessageBox(errorString);
+		return false;
+	}
 
+	// The old response is kept until the new one is ready
 	transferFunctions[i].first = numerator;
 	transferFunctions[i].second = denominator;
+	programs[i] = std::move(program);
+	pending[i] = true;
+
+	StartSolve();
+	StartZoomSolve();
+
+	return true;
+}
 
+wxString DataManager::CompileTransferFunction(const wxString &numerator,
+	const wxString &denominator, CompiledExpression &program) const
+{
 	ExpressionTree expressionTree;
-	wxString errorString;
-	if (frequencyHertz)
-		errorString = expressionTree.Solve(AssembleTransferFunctionString(transferFunctions[i]),
-			minFreq, maxFreq, numberOfPoints, magnitude, phase);
+	return expressionTree.Compile(AssembleTransferFunctionString(numerator, denominator), program);
+}
+
+void DataManager::StartSolve()
+{
+	BackgroundSolver::Job job;
+	job.generation = ++generation;
+	job.grid = targetGrid;
+	if (adaptiveSampling)
+	{
+		// The grid depends on every transfer function
+		job.sampler = std::make_shared<const AdaptiveSampler>(samplingOptions);
+		pending.assign(GetCount(), true);
+	}
+
+	for (unsigned int i = 0; i < GetCount(); ++i)
+	{
+		if (!pending[i])
+			continue;
+
+		job.programs.push_back(programs[i]);
+		job.grids.push_back(nullptr);
+		if (adaptiveSampling || resolutions[i] == 0 || resolutions[i] == resolution)
+			continue;
+
+		job.grids.back() = GetGrid(targetGrid->GetMinimum(), targetGrid->GetMaximum(), resolutions[i]);
+	}
+
+	// Zoom responses are not shown while their transfer function is pending
+	zoomTotalNeedsUpdate = true;
+
+	if (onSolveComplete)
+		solver.Post(std::move(job), onSolveComplete);
 	else
 	{
-		errorString = expressionTree.Solve(AssembleTransferFunctionString(transferFunctions[i]),
-			minFreq * 0.5 / M_PI, maxFreq * 0.5 / M_PI, numberOfPoints, magnitude, phase);
+		// Null if cancelled
+		const std::unique_ptr<BackgroundSolver::Result> result(solver.Solve(job));
+		if (result)
+			ApplySolveResult(*result);
+	}
+}
+
+bool DataManager::ApplySolveResults()
+{
+	bool changed(false);
+	std::unique_ptr<BackgroundSolver::Result> result(solver.TakeResult());
+	if (result && ApplySolveResult(*result))
+		changed = true;
+
+	result = zoomSolver.TakeResult();
+	if (result && ApplyZoomResult(*result))
+		changed = true;
+
+	return changed;
+}
 
-		magnitude.MultiplyXData(2.0 * M_PI);
-		phase.MultiplyXData(2.0 * M_PI);
+bool DataManager::ApplySolveResult(const BackgroundSolver::Result &result)
+{
+	// Changes were made after this job was posted, so a newer job is coming
+	if (result.generation != generation)
+		return false;
+
+	// Every transfer function is solved when the grid changes, so all
+	// responses move to the new grid together
+	const bool newGrid(result.grid != grid);
+	if (newGrid)
+		grid = result.grid;
+
+	// Transfer functions may have been removed while solving, so results are
+	// matched by program rather than by index
+	for (unsigned int j = 0; j < result.programs.size(); ++j)
+	{
+		const auto program(std::find(programs.begin(), programs.end(), result.programs[j]));
+		if (program == programs.end())
+			continue;
+
+		const unsigned int i(static_cast<unsigned int>(program - programs.begin()));
+		responses[i] = result.responses[j];
+		totalResponses[i] = result.totalResponses[j];
+		pending[i] = false;
+
+		totalTree.Set(totalSlots[i], totalResponses[i]->magnitude, totalResponses[i]->phase);
+		if (!newGrid)
+			totalTree.Update(totalSlots[i]);
 	}
 
-	if (!errorString.IsEmpty())
+	if (newGrid)
+		totalTree.Rebuild();
+
+	totalNeedsUpdate = true;
+	zoomTotalNeedsUpdate = true;
+	return true;
+}
+
+void DataManager::SetThreadCount(const unsigned int &count)
+{
+	solver.SetThreadCount(count);
+	zoomSolver.SetThreadCount(count);
+}
+
+bool DataManager::SetVisibleRange(const double &min, const double &max)
+{
+	const double minHz(std::max(min / GetUnitScale(), grid->GetMinimum()));
+	const double maxHz(std::min(max / GetUnitScale(), grid->GetMaximum()));
+
+	// Not worth solving again unless it adds many points to the window for
+	// some curve.  The window is shared by every curve, so none of them is
+	// solved more coarsely there than over the full range.
+	bool fewPoints(minHz < maxHz && CountPoints(*grid, minHz, maxHz) < GetEffectiveResolution() / 2);
+	for (unsigned int i = 0; i < GetCount() && minHz < maxHz && !fewPoints; ++i)
 	{
-		wxMessageBox(errorString);
+		if (responses[i] && CountPoints(*responses[i]->grid, minHz, maxHz) < GetEffectiveResolution(i) / 2)
+			fewPoints = true;
+	}
+
+	if (!fewPoints)
+	{
+		if (!zoomGrid)
+			return false;
+
+		ResetZoom(nullptr);
+		return true;
+	}
+
+	const unsigned int zoomResolution(GetZoomResolution());
+	if (zoomGrid && minHz == zoomGrid->GetMinimum() && maxHz == zoomGrid->GetMaximum() &&
+		zoomGrid->GetSize() == zoomResolution)
 		return false;
+
+	ResetZoom(GetGrid(minHz, maxHz, zoomResolution));
+	return true;
+}
+
+unsigned int DataManager::CountPoints(const FrequencyGrid &curveGrid, const double &minFreq, const double &maxFreq)
+{
+	const std::vector<double>& frequencies(curveGrid.GetFrequencies());
+	return static_cast<unsigned int>(std::upper_bound(frequencies.begin(), frequencies.end(), maxFreq)
+		- std::lower_bound(frequencies.begin(), frequencies.end(), minFreq));
+}
+
+unsigned int DataManager::GetEffectiveResolution() const
+{
+	if (adaptiveSampling)
+		return samplingOptions.maximumPoints;
+	return resolution;
+}
+
+unsigned int DataManager::GetEffectiveResolution(const unsigned int &i) const
+{
+	if (adaptiveSampling || resolutions[i] == 0)
+		return GetEffectiveResolution();
+	return resolutions[i];
+}
+
+unsigned int DataManager::GetZoomResolution() const
+{
+	unsigned int zoomResolution(GetEffectiveResolution());
+	for (unsigned int i = 0; i < GetCount(); ++i)
+		zoomResolution = std::max(zoomResolution, GetEffectiveResolution(i));
+	return zoomResolution;
+}
+
+void DataManager::UpdateZoomResolution()
+{
+	if (zoomGrid && zoomGrid->GetSize() != GetZoomResolution())
+		ResetZoom(GetGrid(zoomGrid->GetMinimum(), zoomGrid->GetMaximum(), GetZoomResolution()));
+}
+
+void DataManager::ResetZoom(std::shared_ptr<const FrequencyGrid> newZoomGrid)
+{
+	zoomGrid = std::move(newZoomGrid);
+	zoomResponses.assign(GetCount(), nullptr);
+	zoomPrograms.assign(GetCount(), nullptr);
+	zoomTotalNeedsUpdate = true;
+
+	// Discards results for the previous window
+	++zoomGeneration;
+	StartZoomSolve();
+}
+
+void DataManager::StartZoomSolve()
+{
+	if (!zoomGrid)
+		return;
+
+	BackgroundSolver::Job job;
+	job.grid = zoomGrid;
+	for (unsigned int i = 0; i < GetCount(); ++i)
+	{
+		if (zoomPrograms[i] == programs[i])
+			continue;
+
+		job.programs.push_back(programs[i]);
+		job.grids.push_back(nullptr);
 	}
 
-	assert(magnitude.GetNumberOfPoints() == amplitudePlots[i]->GetNumberOfPoints());
-	assert(phase.GetNumberOfPoints() == phasePlots[i]->GetNumberOfPoints());
+	// A job already in progress may still be for the current window
+	if (job.programs.empty())
+		return;
+	job.generation = ++zoomGeneration;
 
-	for (unsigned int j = 0; j < magnitude.GetNumberOfPoints(); ++j)
+	if (onSolveComplete)
+		zoomSolver.Post(std::move(job), onSolveComplete);
+	else
 	{
-		amplitudePlots[i]->GetX()[j] = magnitude.GetX()[j];
-		amplitudePlots[i]->GetY()[j] = magnitude.GetY()[j];
-		phasePlots[i]->GetX()[j] = phase.GetX()[j];
-		phasePlots[i]->GetY()[j] = phase.GetY()[j];
+		// Null if cancelled
+		const std::unique_ptr<BackgroundSolver::Result> result(zoomSolver.Solve(job));
+		if (result)
+			ApplyZoomResult(*result);
 	}
+}
 
-	totalNeedsUpdate = true;
+bool DataManager::ApplyZoomResult(const BackgroundSolver::Result &result)
+{
+	if (result.generation != zoomGeneration)
+		return false;
+
+	for (unsigned int j = 0; j < result.programs.size(); ++j)
+	{
+		const auto program(std::find(programs.begin(), programs.end(), result.programs[j]));
+		if (program == programs.end())
+			continue;
 
+		const unsigned int i(static_cast<unsigned int>(program - programs.begin()));
+		zoomResponses[i] = result.responses[j];
+		zoomPrograms[i] = result.programs[j];
+	}
+
+	zoomTotalNeedsUpdate = true;
 	return true;
 }
 
+std::shared_ptr<const DataManager::Response> DataManager::GetZoomResponse(const unsigned int &i) const
+{
+	// Zoom and full range data must be for the same transfer function
+	if (pending[i] || zoomPrograms[i] != programs[i])
+		return nullptr;
+	return zoomResponses[i];
+}
+
+const std::shared_ptr<const DataManager::Response>& DataManager::GetZoomTotalResponse()
+{
+	if (!zoomTotalNeedsUpdate)
+		return zoomTotal;
+
+	zoomTotalNeedsUpdate = false;
+	zoomTotal.reset();
+	if (!zoomGrid || GetCount() == 0)
+		return zoomTotal;
+
+	// Phase is aligned with the full range total when plotted
+	auto newTotal(std::make_shared<Response>());
+	newTotal->grid = zoomGrid;
+	newTotal->magnitude.assign(zoomGrid->GetSize(), 0.0);
+	newTotal->phase.assign(zoomGrid->GetSize(), 0.0);
+	for (unsigned int i = 0; i < GetCount(); ++i)
+	{
+		const std::shared_ptr<const Response> zoom(GetZoomResponse(i));
+		if (!zoom)
+			return zoomTotal;
+
+		for (unsigned int j = 0; j < zoomGrid->GetSize(); ++j)
+		{
+			newTotal->magnitude[j] += zoom->magnitude[j];
+			newTotal->phase[j] += zoom->phase[j];
+		}
+	}
+
+	zoomTotal = std::move(newTotal);
+	return zoomTotal;
+}
+
 void DataManager::SetFrequencyUnitsHertz()
 {
 	if (frequencyHertz)
 		return;
+
 	frequencyHertz = true;
-	UpdateAllTransferFunctionData();
 }
 
 void DataManager::SetFrequencyUnitsRadPerSec()
 {
 	if (!frequencyHertz)
 		return;
+
 	frequencyHertz = false;
-	UpdateAllTransferFunctionData();
+}
+
+double DataManager::GetUnitScale() const
+{
+	if (frequencyHertz)
+		return 1.0;
+	return 2.0 * M_PI;
+}
+
+CurveDecimator::Curve DataManager::GetCurve(const Response &response,
+	const std::shared_ptr<const Response> &zoom, const bool &phase) const
+{
+	const std::vector<double>& x(response.grid->GetFrequencies());
+	const std::vector<double>& y(phase ? response.phase : response.magnitude);
+
+	CurveDecimator::Curve curve;
+	curve.xScale = GetUnitScale();
+	if (!zoom)
+	{
+		curve.spans.push_back({ x.data(), y.data(), static_cast<unsigned int>(x.size()), 0.0 });
+		return curve;
+	}
+
+	const std::vector<double>& zoomX(zoom->grid->GetFrequencies());
+	const std::vector<double>& zoomY(phase ? zoom->phase : zoom->magnitude);
+	const unsigned int first(static_cast<unsigned int>(std::lower_bound(x.begin(), x.end(),
+		zoomX.front()) - x.begin()));
+	const unsigned int last(static_cast<unsigned int>(std::upper_bound(x.begin(), x.end(),
+		zoomX.back()) - x.begin()));
+
+	// Phase over the window may be unwrapped onto a different branch than
+	// phase over the full range
+	double offset(0.0);
+	if (phase)
+	{
+		double reference;
+		if (first == 0)
+			reference = y.front();
+		else if (first == x.size())
+			reference = y.back();
+		else
+			reference = y[first - 1] + (y[first] - y[first - 1])
+				* (zoomX.front() - x[first - 1]) / (x[first] - x[first - 1]);
+		offset = 360.0 * std::round((reference - zoomY.front()) / 360.0);
+	}
+
+	curve.spans.push_back({ x.data(), y.data(), first, 0.0 });
+	curve.spans.push_back({ zoomX.data(), zoomY.data(), static_cast<unsigned int>(zoomX.size()), offset });
+	curve.spans.push_back({ x.data() + last, y.data() + last, static_cast<unsigned int>(x.size()) - last, 0.0 });
+	return curve;
+}
+
+CurveDecimator::Curve DataManager::GetAmplitudeCurve(const unsigned int &i) const
+{
+	return GetCurve(*responses[i], GetZoomResponse(i), false);
+}
+
+CurveDecimator::Curve DataManager::GetPhaseCurve(const unsigned int &i) const
+{
+	return GetCurve(*responses[i], GetZoomResponse(i), true);
+}
+
+CurveDecimator::Curve DataManager::GetTotalAmplitudeCurve()
+{
+	return GetCurve(*GetTotalResponse(), GetZoomTotalResponse(), false);
+}
+
+CurveDecimator::Curve DataManager::GetTotalPhaseCurve()
+{
+	return GetCurve(*GetTotalResponse(), GetZoomTotalResponse(), true);
 }
 
 void DataManager::SetFrequencyRange(const double &min, const double &max)
@@ -104,68 +463,216 @@ void DataManager::SetFrequencyRange(const double &min, const double &max)
 	if (min >= max)
 		return;
 
-	minFreq = min;
-	maxFreq = max;
+	const double minHz(min / GetUnitScale());
+	const double maxHz(max / GetUnitScale());
+	if (minHz == targetGrid->GetMinimum() && maxHz == targetGrid->GetMaximum())
+		return;
+
+	targetGrid = GetGrid(minHz, maxHz, resolution);
 
 	UpdateAllTransferFunctionData();
 }
 
-wxString DataManager::ConstructTotalTransferFunction() const
+bool DataManager::SetAdaptiveSampling(const bool &enabled)
 {
-	wxString totalNum, totalDen;
-	for (unsigned int i = 0; i < transferFunctions.size(); ++i)
+	if (enabled == adaptiveSampling)
+		return true;
+	else if (!CheckMemory(enabled ? EstimateMemory(samplingOptions.maximumPoints, resolutions, true)
+		: EstimateMemory(resolution, resolutions, false)))
+		return false;
+
+	adaptiveSampling = enabled;
+	UpdateAllTransferFunctionData();
+	UpdateZoomResolution();
+	return true;
+}
+
+bool DataManager::SetSamplingOptions(const AdaptiveSampler::Options &options)
+{
+	if (adaptiveSampling && !CheckMemory(EstimateMemory(options.maximumPoints, resolutions, true)))
+		return false;
+
+	samplingOptions = options;
+	if (adaptiveSampling)
 	{
-		totalNum.Append(_T("(") + transferFunctions[i].first + _T(")"));
-		totalDen.Append(_T("(") + transferFunctions[i].second + _T(")"));
-		if (i < transferFunctions.size() - 1)
-		{
-			totalNum.Append(_T("*"));
-			totalDen.Append(_T("*"));
-		}
+		UpdateAllTransferFunctionData();
+		UpdateZoomResolution();
 	}
 
-	return AssembleTransferFunctionString(totalNum, totalDen);
+	return true;
 }
 
-void DataManager::UpdateTotalTransferFunctionData()
+bool DataManager::SetResolution(const unsigned int &resolution)
 {
-	if (!totalNeedsUpdate)
-		return;
+	if (resolution < 2)
+		return false;
+	else if (resolution == this->resolution)
+		return true;
+	else if (!CheckMemory(EstimateMemory(resolution, resolutions, adaptiveSampling)))
+		return false;
 
-	const wxString totalTF(ConstructTotalTransferFunction());
+	this->resolution = resolution;
+	targetGrid = GetGrid(targetGrid->GetMinimum(), targetGrid->GetMaximum(), resolution);
 
-	if (totalTF.IsEmpty())
-		return;
+	// The sampling budget follows the resolution, so both modes give
+	// similar numbers of points
+	samplingOptions.maximumPoints = resolution;
 
-	ExpressionTree expressionTree;
-	if (frequencyHertz)
-		expressionTree.Solve(totalTF, minFreq, maxFreq, numberOfPoints, totalAmplitude, totalPhase);
-	else
+	UpdateAllTransferFunctionData();
+	UpdateZoomResolution();
+	return true;
+}
+
+bool DataManager::SetResolution(const unsigned int &i, const unsigned int &resolution)
+{
+	if (resolution == 1)
+		return false;
+	else if (resolution == resolutions[i])
+		return true;
+
+	// Adaptive sampling ignores per-curve resolutions until it is disabled
+	std::vector<unsigned int> newResolutions(resolutions);
+	newResolutions[i] = resolution;
+	if (!CheckMemory(EstimateMemory(this->resolution, newResolutions, false)))
+		return false;
+
+	resolutions[i] = resolution;
+	if (adaptiveSampling)
+		return true;
+
+	pending[i] = true;
+	StartSolve();
+	UpdateZoomResolution();
+	return true;
+}
+
+std::size_t DataManager::GetMemoryEstimate() const
+{
+	if (adaptiveSampling)
+		return EstimateMemory(samplingOptions.maximumPoints, resolutions, true);
+	return EstimateMemory(resolution, resolutions, false);
+}
+
+std::size_t DataManager::EstimateMemory(const unsigned int &globalPoints,
+	const std::vector<unsigned int> &curveResolutions, const bool &adaptive)
+{
+	// The zoomed window uses the highest resolution of any curve
+	std::size_t zoomPoints(globalPoints);
+	for (const auto& curveResolution : curveResolutions)
 	{
-		expressionTree.Solve(totalTF, minFreq * 0.5 / M_PI,
-			maxFreq * 0.5 / M_PI, numberOfPoints, totalAmplitude, totalPhase);
+		if (!adaptive)
+			zoomPoints = std::max(zoomPoints, static_cast<std::size_t>(curveResolution));
+	}
+
+	// The grid and the zoomed window's grid with their powers of angular
+	// frequency, and the total.  Curves are read in place and decimated to
+	// the width of their plot, so copies for plotting are not counted.
+	const std::size_t gridValues(1 + FrequencyGrid::maximumCachedPower);
+	std::size_t values((gridValues + 2) * globalPoints + gridValues * zoomPoints);
+	for (const auto& curveResolution : curveResolutions)
+	{
+		std::size_t points(globalPoints);
+		if (!adaptive && curveResolution > 0)
+			points = curveResolution;
+
+		// The response and solver scratch space
+		values += 4 * points;
+
+		// Nodes of the total tree, then the response for a zoomed window
+		values += 4 * static_cast<std::size_t>(globalPoints) + 2 * zoomPoints;
+
+		// The response on the global grid when the curve has a grid of its
+		// own (and that grid, which may be shared)
+		if (points != globalPoints)
+			values += 2 * static_cast<std::size_t>(globalPoints) + gridValues * points;
+	}
+
+	return values * sizeof(double);
+}
+
+std::shared_ptr<const FrequencyGrid> DataManager::GetGrid(const double &minFreq,
+	const double &maxFreq, const unsigned int &resolution)
+{
+	gridCache.erase(std::remove_if(gridCache.begin(), gridCache.end(),
+		[](const std::weak_ptr<const FrequencyGrid> &g) { return g.expired(); }), gridCache.end());
 
-		totalAmplitude.MultiplyXData(2.0 * M_PI);
-		totalPhase.MultiplyXData(2.0 * M_PI);
+	for (const auto& cached : gridCache)
+	{
+		std::shared_ptr<const FrequencyGrid> g(cached.lock());
+		if (g && g->GetMinimum() == minFreq && g->GetMaximum() == maxFreq && g->GetSize() == resolution)
+			return g;
 	}
 
+	auto newGrid(std::make_shared<const FrequencyGrid>(minFreq, maxFreq, resolution));
+	gridCache.push_back(newGrid);
+	return newGrid;
+}
+
+bool DataManager::CheckMemory(const std::size_t &estimate) const
+{
+	if (estimate <= memoryLimit)
+		return true;
+
+	wxMessageBox(wxString::Format(_T("This would need about %.2f GB of memory, which is more than the limit of %.2f GB.  Reduce the number of points."),
+		estimate * 1.0e-9, memoryLimit * 1.0e-9), _T("Too Many Points"));
+	return false;
+}
+
+void DataManager::UpdateTotalTransferFunctionData()
+{
+	if (!totalNeedsUpdate)
+		return;
+
 	totalNeedsUpdate = false;
+	if (totalTree.GetMagnitude().empty())
+	{
+		total.reset();
+		return;
+	}
+
+	// The tree is kept up to date as transfer functions change, so only the
+	// root needs to be copied here
+	auto newTotal(std::make_shared<Response>());
+	newTotal->grid = grid;
+	newTotal->magnitude = totalTree.GetMagnitude();
+	newTotal->phase = totalTree.GetPhase();
+
+	ZeroPoleGain::AlignPhase(newTotal->phase);
+	total = std::move(newTotal);
 }
 
 void DataManager::RemoveAllTransferFunctions()
 {
-	amplitudePlots.Clear();
-	phasePlots.Clear();
+	responses.clear();
+	totalResponses.clear();
+	zoomResponses.clear();
+	zoomPrograms.clear();
+	zoomTotalNeedsUpdate = true;
 	transferFunctions.clear();
+	programs.clear();
+	pending.clear();
+	resolutions.clear();
+	totalTree.Clear();
+	totalSlots.clear();
+	totalNeedsUpdate = true;
 
 	// FIXME:  What about total?
 }
 
 void DataManager::RemoveTransferFunctions(const unsigned int &i)
 {
-	amplitudePlots.Remove(i);
-	phasePlots.Remove(i);
+	totalTree.Remove(totalSlots[i]);
+	totalSlots.erase(totalSlots.begin() + i);
+
+	responses.erase(responses.begin() + i);
+	totalResponses.erase(totalResponses.begin() + i);
+	zoomResponses.erase(zoomResponses.begin() + i);
+	zoomPrograms.erase(zoomPrograms.begin() + i);
+	zoomTotalNeedsUpdate = true;
 	transferFunctions.erase(transferFunctions.begin() + i);
+	programs.erase(programs.begin() + i);
+	pending.erase(pending.begin() + i);
+	resolutions.erase(resolutions.begin() + i);
 
 	totalNeedsUpdate = true;
 	UpdateTotalTransferFunctionData();
@@ -173,10 +680,8 @@ void DataManager::RemoveTransferFunctions(const unsigned int &i)
 
 void DataManager::UpdateAllTransferFunctionData()
 {
-	for (unsigned int i = 0; i < amplitudePlots.GetCount(); ++i)
-		UpdateTransferFunction(i, transferFunctions[i].first, transferFunctions[i].second);
-
-	UpdateTotalTransferFunctionData();
+	pending.assign(GetCount(), true);
+	StartSolve();
 }
 
 wxString DataManager::AssembleTransferFunctionString(const wxString &numerator, const wxString &denominator) const
@@ -191,14 +696,8 @@ wxString DataManager::AssembleTransferFunctionString(const std::pair<wxString, w
 	return AssembleTransferFunctionString(tf.first, tf.second);
 }
 
-LibPlot2D::Dataset2D& DataManager::GetTotalAmplitudeData()
-{
-	UpdateTotalTransferFunctionData();
-	return totalAmplitude;
-}
-
-LibPlot2D::Dataset2D& DataManager::GetTotalPhaseData()
+const std::shared_ptr<const DataManager::Response>& DataManager::GetTotalResponse()
 {
 	UpdateTotalTransferFunctionData();
-	return totalPhase;
+	return total;
 }
@@ -14,9 +14,13 @@
 //				 while maintaining separate data for amplitude, phase (and total for
 //				 all TFs).
 
-// LibPlot2D headers
-#include <lp2d/utilities/dataset2D.h>
-#include <lp2d/utilities/managedList.h>
+// Local headers
+#include "compiledExpression.h"
+#include "expressionTree.h"
+#include "responseProductTree.h"
+#include "frequencyGrid.h"
+#include "backgroundSolver.h"
+#include "curveDecimator.h"
 
 // wxWidgets headers
 #include <wx/wx.h>
@@ -24,6 +28,9 @@
 // Standard C++ headers
 #include <vector>
 #include <utility>
+#include <memory>
+#include <functional>
+#include <cstddef>
 
 class DataManager
 {
@@ -33,19 +40,87 @@ public:
 	bool AddTransferFunction(const wxString &numerator, const wxString &denominator);
 	bool UpdateTransferFunction(const unsigned int &i, const wxString &numerator, const wxString &denominator);
 
+	// Changing units does not re-solve; only the displayed X data is scaled
+	bool GetFrequencyUnitsHertz() const { return frequencyHertz; }
 	void SetFrequencyUnitsHertz();
 	void SetFrequencyUnitsRadPerSec();
-	void SetFrequencyRange(const double &min, const double &max);
 
-	LibPlot2D::Dataset2D& GetAmplitudeData(const unsigned int &i) { return *amplitudePlots[i]; }
-	LibPlot2D::Dataset2D& GetPhaseData(const unsigned int &i) { return *phasePlots[i]; }
-	LibPlot2D::Dataset2D& GetTotalAmplitudeData();
-	LibPlot2D::Dataset2D& GetTotalPhaseData();
+	// In the current frequency units; the requested range, which may not be
+	// solved yet
+	void SetFrequencyRange(const double &min, const double &max);
+	double GetMinFrequency() const { return targetGrid->GetMinimum() * GetUnitScale(); }
+	double GetMaxFrequency() const { return targetGrid->GetMaximum() * GetUnitScale(); }
+
+	// When enabled, points are concentrated where any response changes
+	// quickly, and every transfer function is solved again on a new grid
+	// whenever one changes.  The total uses the same grid.
+	bool SetAdaptiveSampling(const bool &enabled);
+	bool GetAdaptiveSampling() const { return adaptiveSampling; }
+	bool SetSamplingOptions(const AdaptiveSampler::Options &options);
+	const AdaptiveSampler::Options& GetSamplingOptions() const { return samplingOptions; }
+
+	// Number of points for transfer functions without a resolution of their
+	// own, and for the total.  Per-curve resolutions of zero use this one,
+	// and are ignored with adaptive sampling.  Changes that would use more
+	// memory than the limit are refused with a warning.
+	bool SetResolution(const unsigned int &resolution);
+	unsigned int GetResolution() const { return resolution; }
+	bool SetResolution(const unsigned int &i, const unsigned int &resolution);
+	unsigned int GetResolution(const unsigned int &i) const { return resolutions[i]; }
+
+	// Approximate, in bytes, for the current transfer functions and settings
+	std::size_t GetMemoryEstimate() const;
+	void SetMemoryLimit(const std::size_t &limit) { memoryLimit = limit; }
+	std::size_t GetMemoryLimit() const { return memoryLimit; }
+
+	// The visible part of the plots, in the current frequency units.  When it
+	// covers only a few of any curve's points, it is solved again at the
+	// highest resolution of any curve, and those results replace the points
+	// within it on every curve.  Returns true if any curve changed.
+	bool SetVisibleRange(const double &min, const double &max);
+
+	// Zero uses one thread per hardware thread
+	void SetThreadCount(const unsigned int &count);
+	unsigned int GetThreadCount() const { return solver.GetThreadCount(); }
+
+	// Without a callback, changes are solved before returning.  With one,
+	// they are solved on a worker thread, the callback is called from that
+	// thread when results are ready, and ApplySolveResults() must then be
+	// called from this thread.  Returns true if any data changed.
+	void SetSolveCompleteCallback(std::function<void()> callback) { onSolveComplete = std::move(callback); }
+	bool ApplySolveResults();
+
+	// The total, and all responses without a resolution of their own, are
+	// computed on this grid
+	const std::shared_ptr<const FrequencyGrid>& GetFrequencyGrid() const { return grid; }
+
+	typedef BackgroundSolver::Response Response;
+
+	// Responses are never modified once solved; re-solving replaces the
+	// pointer, so callers can detect changes by comparing pointers.  A
+	// response is null until it is first solved, and the total is null when
+	// no responses are available.
+	const std::shared_ptr<const Response>& GetResponse(const unsigned int &i) const { return responses[i]; }
+	const std::shared_ptr<const Response>& GetTotalResponse();
+
+	// Responses over the visible range, or null when not zoomed or not yet
+	// solved for the current transfer function
+	std::shared_ptr<const Response> GetZoomResponse(const unsigned int &i) const;
+	const std::shared_ptr<const Response>& GetZoomTotalResponse();
+
+	// Curves for plotting, read in place from the responses, with X data in
+	// the current frequency units.  Zoom responses are merged in where
+	// available.  Curves are only valid while the responses they were made
+	// from are held.
+	CurveDecimator::Curve GetAmplitudeCurve(const unsigned int &i) const;
+	CurveDecimator::Curve GetPhaseCurve(const unsigned int &i) const;
+	CurveDecimator::Curve GetTotalAmplitudeCurve();
+	CurveDecimator::Curve GetTotalPhaseCurve();
 
 	wxString GetNumerator(const unsigned int &i) const { return transferFunctions[i].first; }
 	wxString GetDenominator(const unsigned int &i) const { return transferFunctions[i].second; }
 
-	unsigned int GetCount() const { return amplitudePlots.GetCount(); }
+	unsigned int GetCount() const { return static_cast<unsigned int>(responses.size()); }
 
 	void RemoveAllTransferFunctions();
 	void RemoveTransferFunctions(const unsigned int &i);
@@ -53,22 +128,77 @@ public:
 	void UpdateTotalTransferFunctionData();
 
 private:
-	double minFreq, maxFreq;// [Hz]
+	std::shared_ptr<const FrequencyGrid> grid;
+	std::shared_ptr<const FrequencyGrid> targetGrid;// Differs from grid until solved
 	bool frequencyHertz;
 
-	static const unsigned int numberOfPoints;
+	bool adaptiveSampling;
+	AdaptiveSampler::Options samplingOptions;// For adaptive sampling; targetGrid gives the range
+
+	double GetUnitScale() const;
+
+	// Grids with the same range and resolution are shared while any of them
+	// is in use, so their angular frequencies are only computed once
+	std::vector<std::weak_ptr<const FrequencyGrid>> gridCache;
+	std::shared_ptr<const FrequencyGrid> GetGrid(const double &minFreq,
+		const double &maxFreq, const unsigned int &resolution);
+	CurveDecimator::Curve GetCurve(const Response &response,
+		const std::shared_ptr<const Response> &zoom, const bool &phase) const;
 
-	LibPlot2D::ManagedList<LibPlot2D::Dataset2D> amplitudePlots;
-	LibPlot2D::ManagedList<LibPlot2D::Dataset2D> phasePlots;
+	static const unsigned int defaultResolution;
+	static const std::size_t defaultMemoryLimit;
+	unsigned int resolution;
+	std::vector<unsigned int> resolutions;// Per transfer function; zero for the global resolution
+
+	// Points over the full range, after adaptive sampling's budget and
+	// per-curve resolutions are applied, for the total and for one curve
+	unsigned int GetEffectiveResolution() const;
+	unsigned int GetEffectiveResolution(const unsigned int &i) const;
+	unsigned int GetZoomResolution() const;// Highest of any curve
+	void UpdateZoomResolution();
+	static unsigned int CountPoints(const FrequencyGrid &curveGrid, const double &minFreq, const double &maxFreq);
+	std::size_t memoryLimit;// [bytes]
+
+	static std::size_t EstimateMemory(const unsigned int &globalPoints,
+		const std::vector<unsigned int> &curveResolutions, const bool &adaptive);
+	bool CheckMemory(const std::size_t &estimate) const;
+
+	std::vector<std::shared_ptr<const Response>> responses;
+	std::vector<std::shared_ptr<const Response>> totalResponses;// On grid, for the total
 
 	bool totalNeedsUpdate;
-	LibPlot2D::Dataset2D totalAmplitude;
-	LibPlot2D::Dataset2D totalPhase;
+	ResponseProductTree totalTree;
+	std::vector<unsigned int> totalSlots;// Leaf in totalTree for each transfer function
+	std::shared_ptr<const Response> total;
 
 	std::vector<std::pair<wxString, wxString>> transferFunctions;
-	wxString ConstructTotalTransferFunction() const;
+	std::vector<std::shared_ptr<const CompiledExpression>> programs;
+	std::vector<bool> pending;// True until solved on targetGrid
 	void UpdateAllTransferFunctionData();
 
+	wxString CompileTransferFunction(const wxString &numerator, const wxString &denominator,
+		CompiledExpression &program) const;
+
+	BackgroundSolver solver;
+	std::function<void()> onSolveComplete;
+	unsigned int generation;// Of the most recent job
+	void StartSolve();
+	bool ApplySolveResult(const BackgroundSolver::Result &result);
+
+	// The visible range is solved by its own worker, so zooming does not
+	// cancel changes to the full range
+	std::shared_ptr<const FrequencyGrid> zoomGrid;// nullptr when not zoomed
+	std::vector<std::shared_ptr<const Response>> zoomResponses;
+	std::vector<std::shared_ptr<const CompiledExpression>> zoomPrograms;// Solved for each zoom response
+	bool zoomTotalNeedsUpdate;
+	std::shared_ptr<const Response> zoomTotal;
+
+	BackgroundSolver zoomSolver;
+	unsigned int zoomGeneration;// Of the most recent zoom job
+	void ResetZoom(std::shared_ptr<const FrequencyGrid> newZoomGrid);
+	void StartZoomSolve();
+	bool ApplyZoomResult(const BackgroundSolver::Result &result);
+
 	wxString AssembleTransferFunctionString(const wxString &numerator, const wxString &denominator) const;
 	wxString AssembleTransferFunctionString(const std::pair<wxString, wxString> &tf) const;
 };
@@ -0,0 +1,57 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  evaluationWorkspace.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Pool of buffers used to hold intermediate results while evaluating a
+//				 CompiledExpression.  Intermediate buffers hold one tile of the
+//				 frequency grid, small enough that a whole program's intermediates stay
+//				 in L1 cache.  Buffers only grow, so once a workspace has been used for
+//				 the largest program and grid, evaluating does not allocate.
+
+// Local headers
+#include "evaluationWorkspace.h"
+
+//==========================================================================
+// Class:			EvaluationWorkspace
+// Function:		tileSize
+//
+// Description:		Number of frequencies evaluated at a time.  256 points take
+//					4 kB per buffer, so typical programs keep all of their
+//					intermediate buffers within a 32 kB L1 data cache.
+//
+//==========================================================================
+const unsigned int EvaluationWorkspace::tileSize(256);
+
+//==========================================================================
+// Class:			EvaluationWorkspace
+// Function:		Prepare
+//
+// Description:		Ensures the requested number of intermediate buffers are
+//					available and sizes them.  Existing capacity is reused.
+//
+// Input Arguments:
+//		slotCount	= const unsigned int& number of buffers required
+//		size		= const unsigned int& length of each vector buffer
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void EvaluationWorkspace::Prepare(const unsigned int &slotCount, const unsigned int &size)
+{
+	if (slots.size() < slotCount)
+		slots.resize(slotCount);
+	for (unsigned int i = 0; i < slotCount; ++i)
+		slots[i].Resize(size);
+}
@@ -0,0 +1,44 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  evaluationWorkspace.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Pool of buffers used to hold intermediate results while evaluating a
+//				 CompiledExpression.  Intermediate buffers hold one tile of the
+//				 frequency grid, small enough that a whole program's intermediates stay
+//				 in L1 cache.  Buffers only grow, so once a workspace has been used for
+//				 the largest program and grid, evaluating does not allocate.
+
+#ifndef _EVALUATION_WORKSPACE_H_
+#define _EVALUATION_WORKSPACE_H_
+
+// Local headers
+#include "complexVector.h"
+
+// Standard C++ headers
+#include <vector>
+
+class EvaluationWorkspace
+{
+public:
+	// Number of frequencies evaluated at a time
+	static const unsigned int tileSize;
+
+	void Prepare(const unsigned int &slotCount, const unsigned int &size);
+
+	ComplexVector& GetSlot(const unsigned int &i) { return slots[i]; }
+	ComplexVector& GetResponse() { return response; }
+
+private:
+	std::vector<ComplexVector> slots;
+	ComplexVector response;
+};
+
+#endif// _EVALUATION_WORKSPACE_H_
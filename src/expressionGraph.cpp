@@ -0,0 +1,551 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+// File:  expressionGraph.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Directed acyclic graph form of a compiled expression.  While the graph
+//				 is built, subtrees involving only numbers are folded into constants,
+//				 identical subtrees are merged into a single node and factors common to
+//				 the numerator and denominator of a product are cancelled.  Work
+//				 derived from the graph (evaluation, reduction to a rational function)
+//				 is then done once per unique subexpression.
+
+// Local headers
+#include "expressionGraph.h"
+
+// Standard C++ headers
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		ExpressionGraph
+//
+// Description:		Constructor for ExpressionGraph class.  Builds the graph
+//					from the specified instructions, simplifying as each node
+//					is added.
+//
+// Input Arguments:
+//		instructions	= const std::vector<CompiledExpression::Instruction>&
+//						  in Reverse Polish order
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ExpressionGraph::ExpressionGraph(const std::vector<CompiledExpression::Instruction> &instructions)
+{
+	std::vector<unsigned int> stack;
+	for (const auto& instruction : instructions)
+	{
+		switch (instruction.code)
+		{
+		case CompiledExpression::OpCode::PushConstant:
+			stack.push_back(AddConstant(instruction.value));
+			break;
+
+		case CompiledExpression::OpCode::PushS:
+			stack.push_back(AddNode({ CompiledExpression::OpCode::PushS, 0.0, 0, 0 }));
+			break;
+
+		case CompiledExpression::OpCode::Negate:
+			stack.back() = AddNegate(stack.back());
+			break;
+
+		default:
+			const unsigned int second(stack.back());
+			stack.pop_back();
+			stack.back() = AddOperation(instruction.code, stack.back(), second);
+		}
+	}
+
+	if (stack.empty())
+		return;
+
+	assert(stack.size() == 1);
+	root = stack.back();
+
+	// Only needed while building
+	nodeIndices.clear();
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		GetEvaluationOrder
+//
+// Description:		Returns the nodes that contribute to the result, ordered
+//					so that each node follows its operands.  Nodes left over
+//					from simplification are not included.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<unsigned int>
+//
+//==========================================================================
+std::vector<unsigned int> ExpressionGraph::GetEvaluationOrder() const
+{
+	std::vector<unsigned int> order;
+	if (nodes.empty())
+		return order;
+
+	// Second member is true when the node's operands have been pushed
+	std::vector<std::pair<unsigned int, bool>> stack(1, std::make_pair(root, false));
+	std::vector<bool> visited(nodes.size(), false);
+	while (!stack.empty())
+	{
+		const std::pair<unsigned int, bool> next(stack.back());
+		stack.pop_back();
+		if (next.second)
+		{
+			order.push_back(next.first);
+			continue;
+		}
+		else if (visited[next.first])
+			continue;
+
+		visited[next.first] = true;
+		stack.push_back(std::make_pair(next.first, true));
+
+		const Node& node(nodes[next.first]);
+		if (node.code == CompiledExpression::OpCode::PushConstant ||
+			node.code == CompiledExpression::OpCode::PushS)
+			continue;
+		else if (node.code != CompiledExpression::OpCode::Negate)
+			stack.push_back(std::make_pair(node.second, false));
+		stack.push_back(std::make_pair(node.first, false));
+	}
+
+	return order;
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		IsInteger
+//
+// Description:		Checks if the specified value can be used as an integer
+//					exponent.
+//
+// Input Arguments:
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool ExpressionGraph::IsInteger(const double &value)
+{
+	return value == floor(value) && fabs(value) <= std::numeric_limits<int>::max();
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		AddNode
+//
+// Description:		Adds the specified node to the graph, unless an identical
+//					node already exists.
+//
+// Input Arguments:
+//		node	= const Node&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the node
+//
+//==========================================================================
+unsigned int ExpressionGraph::AddNode(const Node &node)
+{
+	// Constants are compared by bit pattern, so 0.0 and -0.0 remain distinct
+	std::uint64_t valueBits;
+	static_assert(sizeof(valueBits) == sizeof(node.value), "Unexpected size of double");
+	memcpy(&valueBits, &node.value, sizeof(valueBits));
+
+	const NodeKey key(node.code, valueBits, node.first, node.second);
+	const auto existing(nodeIndices.find(key));
+	if (existing != nodeIndices.end())
+		return existing->second;
+
+	const unsigned int index(static_cast<unsigned int>(nodes.size()));
+	products.push_back(CollectFactors(node, index));
+	nodes.push_back(node);
+	nodeIndices[key] = index;
+	return index;
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		AddConstant
+//
+// Description:		Adds a constant node.
+//
+// Input Arguments:
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the node
+//
+//==========================================================================
+unsigned int ExpressionGraph::AddConstant(const double &value)
+{
+	return AddNode({ CompiledExpression::OpCode::PushConstant, value, 0, 0 });
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		AddNegate
+//
+// Description:		Adds a node negating the specified operand.  Constants
+//					are negated directly and double negation is removed.
+//
+// Input Arguments:
+//		operand	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the node
+//
+//==========================================================================
+unsigned int ExpressionGraph::AddNegate(const unsigned int &operand)
+{
+	if (nodes[operand].IsConstant())
+		return AddConstant(-nodes[operand].value);
+	else if (nodes[operand].code == CompiledExpression::OpCode::Negate)
+		return nodes[operand].first;
+
+	return AddNode({ CompiledExpression::OpCode::Negate, 0.0, operand, 0 });
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		AddOperation
+//
+// Description:		Adds a node applying the specified binary operation.
+//					Operations on two constants are folded, operations that
+//					have no effect (multiplying by one, adding zero, etc.) are
+//					removed and products are checked for common factors.
+//
+// Input Arguments:
+//		code	= const CompiledExpression::OpCode&
+//		first	= const unsigned int& (left operand)
+//		second	= const unsigned int& (right operand)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the node
+//
+//==========================================================================
+unsigned int ExpressionGraph::AddOperation(const CompiledExpression::OpCode &code,
+	const unsigned int &first, const unsigned int &second)
+{
+	const Node& a(nodes[first]);
+	const Node& b(nodes[second]);
+	if (a.IsConstant() && b.IsConstant())
+		return AddConstant(CompiledExpression::ApplyOperation(code, a.value, b.value));
+
+	if (b.IsConstant())
+	{
+		if ((b.value == 1.0 && (code == CompiledExpression::OpCode::Multiply ||
+			code == CompiledExpression::OpCode::Divide || code == CompiledExpression::OpCode::Power)) ||
+			(b.value == 0.0 && (code == CompiledExpression::OpCode::Add ||
+			code == CompiledExpression::OpCode::Subtract)))
+			return first;
+	}
+	else if (a.IsConstant())
+	{
+		if ((a.value == 1.0 && code == CompiledExpression::OpCode::Multiply) ||
+			(a.value == 0.0 && code == CompiledExpression::OpCode::Add))
+			return second;
+	}
+
+	unsigned int result;
+	if ((code == CompiledExpression::OpCode::Multiply || code == CompiledExpression::OpCode::Divide) &&
+		CancelFactors(code, first, second, result))
+		return result;
+
+	return AddBinaryNode(code, first, second);
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		AddBinaryNode
+//
+// Description:		Adds a node applying the specified binary operation
+//					without simplifying.  Operands of commutative operations
+//					are put in a consistent order, so a + b and b + a share a
+//					node.  The arithmetic kernels give identical results for
+//					either order.
+//
+// Input Arguments:
+//		code	= const CompiledExpression::OpCode&
+//		first	= const unsigned int& (left operand)
+//		second	= const unsigned int& (right operand)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the node
+//
+//==========================================================================
+unsigned int ExpressionGraph::AddBinaryNode(const CompiledExpression::OpCode &code,
+	const unsigned int &first, const unsigned int &second)
+{
+	if ((code == CompiledExpression::OpCode::Add || code == CompiledExpression::OpCode::Multiply) &&
+		second < first)
+		return AddNode({ code, 0.0, second, first });
+	return AddNode({ code, 0.0, first, second });
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		CollectFactors
+//
+// Description:		Breaks the specified node into factors raised to integer
+//					powers and a constant coefficient.  The products of the
+//					node's operands are already known, so each node is only
+//					collected once, when it is added.
+//
+// Input Arguments:
+//		node	= const Node&
+//		index	= const unsigned int&, of the node
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Product
+//
+//==========================================================================
+ExpressionGraph::Product ExpressionGraph::CollectFactors(const Node &node, const unsigned int &index) const
+{
+	// Limits the size of the exponents that are accumulated
+	const int maxPower(1024);
+
+	Product product;
+	if (node.IsConstant())
+	{
+		product.coefficient = node.value;
+		return product;
+	}
+	else if (node.code == CompiledExpression::OpCode::Multiply)
+		return MergeFactors(products[node.first], products[node.second], false);
+	else if (node.code == CompiledExpression::OpCode::Divide)
+		return MergeFactors(products[node.first], products[node.second], true);
+	else if (node.code == CompiledExpression::OpCode::Negate)
+	{
+		product = products[node.first];
+		product.coefficient = -product.coefficient;
+		return product;
+	}
+
+	unsigned int base(index);
+	int power(1);
+	if (node.code == CompiledExpression::OpCode::Power && nodes[node.second].IsConstant() &&
+		IsInteger(nodes[node.second].value) && fabs(nodes[node.second].value) <= maxPower)
+	{
+		base = node.first;
+		power = static_cast<int>(nodes[node.second].value);
+	}
+
+	if (power > 0)
+		product.factors.push_back({ base, power, 0 });
+	else if (power < 0)
+		product.factors.push_back({ base, 0, -power });
+
+	return product;
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		MergeFactors
+//
+// Description:		Combines the factors of a product or quotient.  Products
+//					with too many factors are marked incomplete instead, which
+//					bounds the work done for each node of long products.
+//
+// Input Arguments:
+//		first	= const Product& (left operand)
+//		second	= const Product& (right operand)
+//		divide	= const bool&, true if the second operand is a divisor
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Product
+//
+//==========================================================================
+ExpressionGraph::Product ExpressionGraph::MergeFactors(const Product &first,
+	const Product &second, const bool &divide)
+{
+	// Cancellation is not attempted for products with more distinct factors
+	const unsigned int maxFactors(64);
+
+	Product product;
+	product.isComplete = first.isComplete && second.isComplete;
+	if (!product.isComplete)
+		return product;
+
+	product.coefficient = divide ? first.coefficient / second.coefficient
+		: first.coefficient * second.coefficient;
+
+	// Factors are sorted by node
+	product.factors.reserve(first.factors.size() + second.factors.size());
+	auto i(first.factors.begin()), j(second.factors.begin());
+	while (i != first.factors.end() || j != second.factors.end())
+	{
+		if (j == second.factors.end() || (i != first.factors.end() && i->node < j->node))
+		{
+			product.factors.push_back(*i++);
+			continue;
+		}
+
+		Factor factor(*j++);
+		if (divide)
+			std::swap(factor.numerator, factor.denominator);
+
+		if (i != first.factors.end() && i->node == factor.node)
+		{
+			factor.numerator += i->numerator;
+			factor.denominator += i->denominator;
+			++i;
+		}
+		product.factors.push_back(factor);
+	}
+
+	if (product.factors.size() > maxFactors)
+	{
+		product.isComplete = false;
+		product.factors.clear();
+	}
+
+	return product;
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		CancelFactors
+//
+// Description:		Checks the product or quotient of the specified operands
+//					for factors that appear in both the numerator and the
+//					denominator.  If any are found, the simplified product is
+//					added to the graph.
+//
+// Input Arguments:
+//		code	= const CompiledExpression::OpCode&, Multiply or Divide
+//		first	= const unsigned int& (left operand)
+//		second	= const unsigned int& (right operand)
+//
+// Output Arguments:
+//		result	= unsigned int&, index of the simplified node
+//
+// Return Value:
+//		bool, true if factors were cancelled
+//
+//==========================================================================
+bool ExpressionGraph::CancelFactors(const CompiledExpression::OpCode &code,
+	const unsigned int &first, const unsigned int &second, unsigned int &result)
+{
+	const Product product(MergeFactors(products[first], products[second],
+		code == CompiledExpression::OpCode::Divide));
+	if (!product.isComplete)
+		return false;
+
+	bool cancelled(false);
+	std::vector<std::pair<unsigned int, int>> factors;
+	for (const auto& factor : product.factors)
+	{
+		if (factor.numerator > 0 && factor.denominator > 0)
+			cancelled = true;
+		if (factor.numerator != factor.denominator)
+			factors.push_back(std::make_pair(factor.node, factor.numerator - factor.denominator));
+	}
+
+	if (!cancelled)
+		return false;
+
+	result = BuildProduct(product.coefficient, factors);
+	return true;
+}
+
+//==========================================================================
+// Class:			ExpressionGraph
+// Function:		BuildProduct
+//
+// Description:		Adds nodes for the product of the specified coefficient
+//					and factors.  Factors with negative exponents are placed
+//					in the denominator.
+//
+// Input Arguments:
+//		coefficient	= const double&
+//		factors		= const std::vector<std::pair<unsigned int, int>>& node
+//					  indices and exponents
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the node
+//
+//==========================================================================
+unsigned int ExpressionGraph::BuildProduct(const double &coefficient,
+	const std::vector<std::pair<unsigned int, int>> &factors)
+{
+	bool hasNumerator(false), hasDenominator(false);
+	unsigned int numerator(0), denominator(0);
+	for (const auto& factor : factors)
+	{
+		unsigned int term(factor.first);
+		if (abs(factor.second) > 1)
+			term = AddBinaryNode(CompiledExpression::OpCode::Power, term, AddConstant(abs(factor.second)));
+
+		if (factor.second > 0)
+		{
+			numerator = hasNumerator ? AddBinaryNode(CompiledExpression::OpCode::Multiply, numerator, term) : term;
+			hasNumerator = true;
+		}
+		else
+		{
+			denominator = hasDenominator ? AddBinaryNode(CompiledExpression::OpCode::Multiply, denominator, term) : term;
+			hasDenominator = true;
+		}
+	}
+
+	if (!hasNumerator)
+		numerator = AddConstant(coefficient);
+	else if (coefficient != 1.0)
+		numerator = AddBinaryNode(CompiledExpression::OpCode::Multiply, AddConstant(coefficient), numerator);
+
+	if (!hasDenominator)
+		return numerator;
+	return AddBinaryNode(CompiledExpression::OpCode::Divide, numerator, denominator);
+}
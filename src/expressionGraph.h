@@ -0,0 +1,98 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+// File:  expressionGraph.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Directed acyclic graph form of a compiled expression.  While the graph
+//				 is built, subtrees involving only numbers are folded into constants,
+//				 identical subtrees are merged into a single node and factors common to
+//				 the numerator and denominator of a product are cancelled.  Work
+//				 derived from the graph (evaluation, reduction to a rational function)
+//				 is then done once per unique subexpression.
+
+#ifndef _EXPRESSION_GRAPH_H_
+#define _EXPRESSION_GRAPH_H_
+
+// Local headers
+#include "compiledExpression.h"
+
+// Standard C++ headers
+#include <vector>
+#include <map>
+#include <tuple>
+#include <cstdint>
+
+class ExpressionGraph
+{
+public:
+	struct Node
+	{
+		CompiledExpression::OpCode code;// PushConstant, PushS, Negate or a binary operation
+		double value;// Only used by PushConstant
+		unsigned int first;// Operands, only used by operations
+		unsigned int second;
+
+		bool IsConstant() const { return code == CompiledExpression::OpCode::PushConstant; }
+	};
+
+	ExpressionGraph() = default;
+	explicit ExpressionGraph(const std::vector<CompiledExpression::Instruction> &instructions);
+
+	bool IsEmpty() const { return nodes.empty(); }
+	const Node& GetNode(const unsigned int &i) const { return nodes[i]; }
+	unsigned int GetNodeCount() const { return static_cast<unsigned int>(nodes.size()); }
+	unsigned int GetRoot() const { return root; }
+
+	// Nodes reachable from the root, with each node after its operands
+	std::vector<unsigned int> GetEvaluationOrder() const;
+
+	static bool IsInteger(const double &value);
+
+private:
+	std::vector<Node> nodes;
+	unsigned int root = 0;
+
+	typedef std::tuple<CompiledExpression::OpCode, std::uint64_t, unsigned int, unsigned int> NodeKey;
+	std::map<NodeKey, unsigned int> nodeIndices;
+
+	unsigned int AddNode(const Node &node);
+	unsigned int AddConstant(const double &value);
+	unsigned int AddNegate(const unsigned int &operand);
+	unsigned int AddOperation(const CompiledExpression::OpCode &code,
+		const unsigned int &first, const unsigned int &second);
+	unsigned int AddBinaryNode(const CompiledExpression::OpCode &code,
+		const unsigned int &first, const unsigned int &second);
+
+	// Factors of a product, sorted by node; exponents contributed by the
+	// numerator and denominator are counted separately so cancellation can
+	// be detected.  Incomplete products have too many factors to track.
+	struct Factor
+	{
+		unsigned int node;
+		int numerator;
+		int denominator;
+	};
+
+	struct Product
+	{
+		bool isComplete = true;
+		double coefficient = 1.0;
+		std::vector<Factor> factors;
+	};
+
+	std::vector<Product> products;// One per node
+
+	Product CollectFactors(const Node &node, const unsigned int &index) const;
+	static Product MergeFactors(const Product &first, const Product &second, const bool &divide);
+	bool CancelFactors(const CompiledExpression::OpCode &code, const unsigned int &first,
+		const unsigned int &second, unsigned int &result);
+	unsigned int BuildProduct(const double &coefficient, const std::vector<std::pair<unsigned int, int>> &factors);
+};
+
+#endif// _EXPRESSION_GRAPH_H_
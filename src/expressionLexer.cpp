@@ -0,0 +1,182 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  expressionLexer.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Splits an expression into tokens in a single pass.  Tokens refer to
+//				 the expression by offset and length, so no text is copied.
+
+// Local headers
+#include "expressionLexer.h"
+
+// Standard C++ headers
+#include <cwctype>
+
+//==========================================================================
+// Class:			ExpressionLexer
+// Function:		ExpressionLexer
+//
+// Description:		Constructor for ExpressionLexer class.
+//
+// Input Arguments:
+//		expression	= const std::wstring_view&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ExpressionLexer::ExpressionLexer(const std::wstring_view &expression) : expression(expression)
+{
+}
+
+//==========================================================================
+// Class:			ExpressionLexer
+// Function:		Next
+//
+// Description:		Skips whitespace and reads the next token.  If an
+//					unrecognized character is found, the position is left at
+//					that character.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		token	= Token&
+//
+// Return Value:
+//		bool, true if a token was read, false otherwise
+//
+//==========================================================================
+bool ExpressionLexer::Next(Token &token)
+{
+	while (position < expression.length() && std::iswspace(expression[position]))
+		++position;
+
+	if (position == expression.length())
+		return false;
+
+	token.offset = position;
+	token.length = 1;
+	token.symbol = expression[position];
+
+	if (NextIsNumber(token.length))
+		token.type = Token::Type::Number;
+	else if (token.symbol == 's' || token.symbol == 'S')
+		token.type = Token::Type::S;
+	else if (IsOperator(token.symbol))
+		token.type = Token::Type::Operator;
+	else if (token.symbol == '(')
+		token.type = Token::Type::OpenParenthese;
+	else if (token.symbol == ')')
+		token.type = Token::Type::CloseParenthese;
+	else
+		return false;
+
+	expectOperand = token.type == Token::Type::Operator ||
+		token.type == Token::Type::OpenParenthese;
+	position += token.length;
+	return true;
+}
+
+//==========================================================================
+// Class:			ExpressionLexer
+// Function:		NextIsNumber
+//
+// Description:		Determines if a number begins at the current position.
+//					Numbers are digits with at most one decimal point, and may
+//					be preceded by a minus sign where an operand is expected.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		length	= unsigned int& indicating length of number
+//
+// Return Value:
+//		bool, true if a number is next in the expression
+//
+//==========================================================================
+bool ExpressionLexer::NextIsNumber(unsigned int &length) const
+{
+	unsigned int i(position);
+	if (expression[i] == '-' && expectOperand && i + 1 < expression.length() &&
+		(IsDigit(expression[i + 1]) || expression[i + 1] == '.'))
+		++i;
+
+	bool foundDecimal(false);
+	if (expression[i] == '.')
+		foundDecimal = true;
+	else if (!IsDigit(expression[i]))
+		return false;
+
+	for (++i; i < expression.length(); ++i)
+	{
+		if (expression[i] == '.')
+		{
+			if (foundDecimal)
+				return false;
+			foundDecimal = true;
+		}
+		else if (!IsDigit(expression[i]))
+			break;
+	}
+
+	length = i - position;
+	return true;
+}
+
+//==========================================================================
+// Class:			ExpressionLexer
+// Function:		IsDigit
+//
+// Description:		Determines if the specified character is a decimal digit.
+//
+// Input Arguments:
+//		c	= const wchar_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if c is between '0' and '9'
+//
+//==========================================================================
+bool ExpressionLexer::IsDigit(const wchar_t &c)
+{
+	return c >= '0' && c <= '9';
+}
+
+//==========================================================================
+// Class:			ExpressionLexer
+// Function:		IsOperator
+//
+// Description:		Determines if the specified character is an operator.
+//
+// Input Arguments:
+//		c	= const wchar_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if c is an operator
+//
+//==========================================================================
+bool ExpressionLexer::IsOperator(const wchar_t &c)
+{
+	return c == '+' ||// From least precedence
+		c == '-' ||
+		c == '*' ||
+		c == '/' ||
+		c == '^';// To most precedence
+}
@@ -0,0 +1,65 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  expressionLexer.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Splits an expression into tokens in a single pass.  Tokens refer to
+//				 the expression by offset and length, so no text is copied.
+
+#ifndef _EXPRESSION_LEXER_H_
+#define _EXPRESSION_LEXER_H_
+
+// Standard C++ headers
+#include <string_view>
+
+class ExpressionLexer
+{
+public:
+	// The expression must remain valid while the lexer and its tokens are in use
+	explicit ExpressionLexer(const std::wstring_view &expression);
+
+	struct Token
+	{
+		enum class Type
+		{
+			Number,
+			S,
+			Operator,
+			OpenParenthese,
+			CloseParenthese
+		};
+
+		Type type;
+		unsigned int offset;// Position of the first character in the expression
+		unsigned int length;
+		wchar_t symbol;// First character
+	};
+
+	// Returns false at the end of the expression or at an unrecognized character
+	bool Next(Token &token);
+
+	bool IsAtEnd() const { return position == expression.length(); }
+	unsigned int GetPosition() const { return position; }
+
+private:
+	const std::wstring_view expression;
+	unsigned int position = 0;
+
+	// True at the start and after operators and open parentheses, where a minus
+	// sign followed by a digit begins a negative number rather than a subtraction
+	bool expectOperand = true;
+
+	bool NextIsNumber(unsigned int &length) const;
+
+	static bool IsDigit(const wchar_t &c);
+	static bool IsOperator(const wchar_t &c);
+};
+
+#endif// _EXPRESSION_LEXER_H_
@@ -14,7 +14,8 @@
 
 // Local headers
 #include "expressionTree.h"
-#include "tfpMath.h"
+#include "expressionGraph.h"
+#include "expressionLexer.h"
 
 // LibPlot2D headers
 #include <lp2d/utilities/math/plotMath.h>
@@ -22,6 +23,24 @@
 // wxWidgets headers
 #include <wx/wx.h>
 
+// Standard C++ headers
+#include <algorithm>
+#include <cwchar>
+
+// Expressions that would expand to polynomials of higher order than this
+// are evaluated operation-by-operation instead
+const unsigned int ExpressionTree::maxRationalOrder(200);
+
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		minimumChunkSize
+//
+// Description:		Smallest number of frequencies handed to a thread at once.
+//					Below this, the cost of waking threads outweighs the gain.
+//
+//==========================================================================
+const unsigned int ExpressionTree::minimumChunkSize(1024);
+
 //==========================================================================
 // Class:			ExpressionTree
 // Function:		Solve
@@ -30,9 +49,13 @@
 //
 // Input Arguments:
 //		expression	= wxString containing the expression to parse
+//		minFreq		= const double& indicating the minimum frequency [Hz]
+//		maxFreq		= const double& indicating the maximum frequency [Hz]
+//		resolution	= const unsigned int& number of frequencies
 //
 // Output Arguments:
-//		solvedData	= Dataset2D& containing the evaluated data
+//		magnitude	= Dataset2D& containing the evaluated magnitude [dB]
+//		phase		= Dataset2D& containing the evaluated phase [deg]
 //
 // Return Value:
 //		wxString, empty for success, error string if unsuccessful
@@ -41,73 +64,245 @@
 wxString ExpressionTree::Solve(wxString expression, const double &minFreq,
 	const double &maxFreq, const unsigned int &resolution, LibPlot2D::Dataset2D &magnitude, LibPlot2D::Dataset2D &phase)
 {
-	if (!ParenthesesBalanced(expression))
-		return _T("Imbalanced parentheses!");
-
-	wxString errorString;
-	errorString = ParseExpression(expression);
-
+	CompiledExpression program;
+	wxString errorString(Compile(expression, program));
 	if (!errorString.IsEmpty())
 		return errorString;
 
-	PrepareDataset(minFreq, maxFreq, resolution, magnitude, phase);
+	Solve(program, minFreq, maxFreq, resolution, magnitude, phase);
+	return wxEmptyString;
+}
+
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		Solve
+//
+// Description:		Evaluates a previously compiled expression on a new
+//					frequency grid.
+//
+// Input Arguments:
+//		program		= const CompiledExpression&
+//		minFreq		= const double& indicating the minimum frequency [Hz]
+//		maxFreq		= const double& indicating the maximum frequency [Hz]
+//		resolution	= const unsigned int& number of frequencies
+//
+// Output Arguments:
+//		magnitude	= Dataset2D& containing the evaluated magnitude [dB]
+//		phase		= Dataset2D& containing the evaluated phase [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ExpressionTree::Solve(const CompiledExpression &program, const double &minFreq,
+	const double &maxFreq, const unsigned int &resolution, LibPlot2D::Dataset2D &magnitude, LibPlot2D::Dataset2D &phase)
+{
+	const FrequencyGrid grid(minFreq, maxFreq, resolution);
+	magnitude.Resize(resolution);
+	phase.Resize(resolution);
+	magnitude.GetX() = grid.GetFrequencies();
+	phase.GetX() = grid.GetFrequencies();
+
+	Solve(program, grid, magnitude.GetY(), phase.GetY());
+}
+
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		Solve
+//
+// Description:		Evaluates a previously compiled expression.  No parsing
+//					is done here, so this is the preferred method when the
+//					same expression is solved repeatedly.  When the factored
+//					form is available, magnitude and phase are computed from
+//					it directly.  Cancellation is checked before each chunk.
+//
+// Input Arguments:
+//		program		= const CompiledExpression&
+//		grid		= const FrequencyGrid&
+//		cancel		= const std::atomic<bool>*, may be nullptr
+//
+// Output Arguments:
+//		magnitude	= std::vector<double>& containing the evaluated magnitude [dB]
+//		phase		= std::vector<double>& containing the evaluated phase [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ExpressionTree::Solve(const CompiledExpression &program, const FrequencyGrid &grid,
+	std::vector<double> &magnitude, std::vector<double> &phase, const std::atomic<bool> *cancel)
+{
+	const unsigned int resolution(grid.GetSize());
+	magnitude.resize(resolution);
+	phase.resize(resolution);
+
+	ThreadPool& pool(GetThreadPool());
+	if (workspaces.size() < pool.GetThreadCount())
+		workspaces.resize(pool.GetThreadCount());
+
+	// Any thread may be given any chunk, so every workspace must be ready
+	for (auto& workspace : workspaces)
+		program.PrepareWorkspace(workspace);
 
-	errorString = EvaluateExpression();
+	if (!program.IsFactored())
+		response.Resize(resolution);
 
-	if (errorString.IsEmpty())
+	pool.ParallelFor(resolution, GetChunkSize(resolution, pool.GetThreadCount()),
+		[&](const unsigned int &start, const unsigned int &end, const unsigned int &thread)
 	{
-		magnitude += TFPMath::GetMagnitudeData(dataVector);
-		magnitude = TFPMath::ConvertToDecibels(magnitude);
-		phase += TFPMath::GetPhaseData(dataVector);
-	}
+		if (cancel && *cancel)
+			return;
+
+		program.EvaluateBode(grid, start, end, workspaces[thread], response, magnitude, phase);
+	});
+
+	if (cancel && *cancel)
+		return;
 
-	return errorString;
+	program.CorrectPhase(phase);
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		ParenthesesBalanced
+// Function:		Solve
 //
-// Description:		Checks to see if the expression has balanced parentheses.
+// Description:		Evaluates several previously compiled expressions.  Each
+//					task is split into chunks of the same size, chosen from
+//					the total number of frequencies, and the chunks of all
+//					tasks are handed out together.  Cancellation is checked
+//					before each chunk.
 //
 // Input Arguments:
-//		expression	= const wxString&
+//		tasks		= const std::vector<SolveTask>&, outputs are resized
+//		cancel		= const std::atomic<bool>*, may be nullptr
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		bool, true if parentheses are balanced, false otherwise
+//		None
 //
 //==========================================================================
-bool ExpressionTree::ParenthesesBalanced(const wxString &expression) const
+void ExpressionTree::Solve(const std::vector<SolveTask> &tasks, const std::atomic<bool> *cancel)
 {
-	unsigned int leftCount(0), rightCount(0);
-	int location = expression.find(_T("("));
+	const unsigned int taskCount(static_cast<unsigned int>(tasks.size()));
+	if (taskCount == 0)
+		return;
+
+	ThreadPool& pool(GetThreadPool());
+	if (workspaces.size() < pool.GetThreadCount())
+		workspaces.resize(pool.GetThreadCount());
 
-	while (location != wxNOT_FOUND)
+	if (taskResponses.size() < taskCount)
+		taskResponses.resize(taskCount);
+
+	unsigned int totalSize(0);
+	for (unsigned int i = 0; i < taskCount; ++i)
 	{
-		++leftCount;
-		location = expression.find(_T("("), location + 1);
+		const unsigned int size(tasks[i].grid->GetSize());
+		tasks[i].magnitude->resize(size);
+		tasks[i].phase->resize(size);
+		if (!tasks[i].program->IsFactored())
+			taskResponses[i].Resize(size);
+		for (auto& workspace : workspaces)
+			tasks[i].program->PrepareWorkspace(workspace);
+		totalSize += size;
 	}
 
-	location = expression.find(_T(")"));
+	const unsigned int chunkSize(GetChunkSize(totalSize, pool.GetThreadCount()));
+	taskChunks.resize(taskCount + 1);
+	taskChunks[0] = 0;
+	for (unsigned int i = 0; i < taskCount; ++i)
+		taskChunks[i + 1] = taskChunks[i] + (tasks[i].grid->GetSize() + chunkSize - 1) / chunkSize;
 
-	while (location != wxNOT_FOUND)
+	pool.ParallelFor(taskChunks.back(), 1,
+		[&](const unsigned int &begin, const unsigned int &end, const unsigned int &thread)
 	{
-		++rightCount;
-		location = expression.find(_T(")"), location + 1);
-	}
+		for (unsigned int chunk = begin; chunk < end; ++chunk)
+		{
+			if (cancel && *cancel)
+				return;
+
+			const unsigned int i(static_cast<unsigned int>(std::upper_bound(
+				taskChunks.begin(), taskChunks.end(), chunk) - taskChunks.begin()) - 1);
+			const FrequencyGrid& grid(*tasks[i].grid);
+			const unsigned int start((chunk - taskChunks[i]) * chunkSize);
+			tasks[i].program->EvaluateBode(grid, start, std::min(start + chunkSize, grid.GetSize()),
+				workspaces[thread], taskResponses[i], *tasks[i].magnitude, *tasks[i].phase);
+		}
+	});
 
-	if (leftCount != rightCount)
-		return false;
+	// Each program's phase is corrected as a whole, so programs are the unit of work here
+	pool.ParallelFor(taskCount, 1,
+		[&](const unsigned int &begin, const unsigned int &end, const unsigned int &)
+	{
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			if (cancel && *cancel)
+				return;
 
-	return true;
+			tasks[i].program->CorrectPhase(*tasks[i].phase);
+		}
+	});
+}
+
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		Compile
+//
+// Description:		Parses the expression and converts it into a program that
+//					can be evaluated any number of times.
+//
+// Input Arguments:
+//		expression	= wxString containing the expression to parse
+//
+// Output Arguments:
+//		program		= CompiledExpression&
+//
+// Return Value:
+//		wxString, empty for success, error string if unsuccessful
+//
+//==========================================================================
+wxString ExpressionTree::Compile(wxString expression, CompiledExpression &program)
+{
+	const std::wstring_view text(expression.wc_str(), expression.length());
+	if (!ParenthesesBalanced(text))
+		return _T("Imbalanced parentheses!");
+
+	wxString errorString;
+	errorString = ParseExpression(text);
+
+	if (!errorString.IsEmpty())
+		return errorString;
+
+	return BuildProgram(text, program);
+}
+
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		ParenthesesBalanced
+//
+// Description:		Checks to see if the expression has balanced parentheses.
+//
+// Input Arguments:
+//		expression	= const std::wstring_view&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if parentheses are balanced, false otherwise
+//
+//==========================================================================
+bool ExpressionTree::ParenthesesBalanced(const std::wstring_view &expression) const
+{
+	return std::count(expression.begin(), expression.end(), '(') ==
+		std::count(expression.begin(), expression.end(), ')');
 }
 
 wxString ExpressionTree::CheckExpression(wxString expression)
 {
-	return ParseExpression(expression);
+	return ParseExpression(std::wstring_view(expression.wc_str(), expression.length()));
 }
 
 //==========================================================================
@@ -116,10 +311,12 @@ wxString ExpressionTree::CheckExpression(wxString expression)
 //
 // Description:		Parses the expression and produces a queue of Reverse
 //					Polish Notation values and operations.  Implements the
-//					shunting-yard algorithm as described by Wikipedia.
+//					shunting-yard algorithm as described by Wikipedia.  The
+//					expression is read once from start to end, so parsing
+//					time is linear in its length.
 //
 // Input Arguments:
-//		expression	= const wxString& to be parsed
+//		expression	= const std::wstring_view& to be parsed
 //
 // Output Arguments:
 //		None
@@ -128,117 +325,154 @@ wxString ExpressionTree::CheckExpression(wxString expression)
 //		wxString containing error descriptions or an empty string on success
 //
 //==========================================================================
-wxString ExpressionTree::ParseExpression(const wxString &expression)
+wxString ExpressionTree::ParseExpression(const std::wstring_view &expression)
 {
-	std::stack<wxString> operatorStack;
+	std::stack<Token> operatorStack;
 	bool lastWasOperator(true);
-	wxString errorString;
 
-	for (unsigned int i = 0; i < expression.Len(); ++i)
-	{
-		if (expression.Mid(i, 1).Trim().IsEmpty())
-			continue;
+	outputQueue = std::queue<Token>();
 
-		unsigned int advance;
-		errorString = ParseNext(expression.Mid(i), lastWasOperator,
-			advance, operatorStack);
-		if (!errorString.IsEmpty())
-			return errorString;
-		i += advance - 1;
-	}
+	ExpressionLexer lexer(expression);
+	Token token;
+	while (lexer.Next(token))
+		ParseNext(token, lastWasOperator, operatorStack);
+
+	if (!lexer.IsAtEnd())
+		return _T("Unrecognized character:  '") +
+			wxString(expression[lexer.GetPosition()]) + _T("'.");
 
 	if (!EmptyStackToQueue(operatorStack))
-		errorString = _T("Imbalanced parentheses!");
+		return _T("Imbalanced parentheses!");
 
-	return errorString;
+	return wxEmptyString;
 }
 
 //=============================================================================
 // Class:			ExpressionTree
 // Function:		ParseNext
 //
-// Description:		Parses the expression and processes the next item.
+// Description:		Processes the next token.
 //
 // Input Arguments:
-//		expression		= const wxString&
+//		token			= const Token&
 //		lastWasOperator	= bool&
-//		advance			= unsigned int&
-//		operatorStack	= std::stack<wxString>&
+//		operatorStack	= std::stack<Token>&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		wxString containing any errors
+//		None
 //
 //=============================================================================
-wxString ExpressionTree::ParseNext(const wxString &expression,
-	bool &lastWasOperator, unsigned int &advance,
-	std::stack<wxString> &operatorStack)
+void ExpressionTree::ParseNext(const Token &token, bool &lastWasOperator,
+	std::stack<Token> &operatorStack)
 {
 	bool thisWasOperator(false);
-	if (NextIsNumber(expression, &advance, lastWasOperator))
-		outputQueue.push(expression.Mid(0, advance));
-	else if (NextIsS(expression, &advance))
-		outputQueue.push(expression.Mid(0, advance));
-	else if (NextIsOperator(expression, &advance))
+	switch (token.type)
 	{
-		ProcessOperator(operatorStack, expression.Mid(0, advance));
+	case Token::Type::Number:
+	case Token::Type::S:
+		outputQueue.push(token);
+		break;
+
+	case Token::Type::Operator:
+		ProcessOperator(operatorStack, token);
 		thisWasOperator = true;
-	}
-	else if (expression[0] == '(')
-	{
+		break;
+
+	case Token::Type::OpenParenthese:
 		if (!lastWasOperator)
-			operatorStack.push(_T("*"));
-		operatorStack.push(expression[0]);
-		advance = 1;
-		thisWasOperator = true;	}
-	else if (expression[0] == ')')
-	{
+			operatorStack.push(Token{ Token::Type::Operator, token.offset, 0, '*' });
+		operatorStack.push(token);
+		thisWasOperator = true;
+		break;
+
+	case Token::Type::CloseParenthese:
 		ProcessCloseParenthese(operatorStack);
-		advance = 1;
+		break;
 	}
-	else
-		return _T("Unrecognized character:  '") + expression.Mid(0, 1) + _T("'.");
 
 	lastWasOperator = thisWasOperator;
-	return wxEmptyString;
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		PrepareDataset
+// Function:		SetThreadCount
 //
-// Description:		Sizes the dataset and populates the x-axis with frequency
-//					data.  Frequencies are spaced logarithmically.
+// Description:		Sets the number of threads used to solve expressions.  The
+//					threads are started the next time an expression is solved.
 //
 // Input Arguments:
-//		minFreq		= const double& indicating the minimum frequency [Hz]
-//		maxFreq		= const double& indicating the maximum frequency [Hz]
-//		resolution	= const unsigned int& number of frequencies
+//		count	= const unsigned int&, zero for one per hardware thread
 //
 // Output Arguments:
-//		data		= Dataset2D&
+//		None
 //
 // Return Value:
 //		None
 //
 //==========================================================================
-void ExpressionTree::PrepareDataset(const double &minFreq, const double &maxFreq,
-	const unsigned int &resolution, LibPlot2D::Dataset2D &magnitude, LibPlot2D::Dataset2D &phase)
+void ExpressionTree::SetThreadCount(const unsigned int &count)
 {
-	magnitude.Resize(resolution);
-	dataVector.assign(resolution, LibPlot2D::Complex(0.0, 0.0));
+	if (count == threadCount)
+		return;
 
-	for (unsigned int i = 0; i < resolution; ++i)
-	{
-		magnitude.GetX()[i] = pow(10.0,
-			(double)i / (double)(resolution - 1) * log10(maxFreq / minFreq) + log10(minFreq));
-		magnitude.GetY()[i] = 0.0;
-		dataVector[i] = LibPlot2D::Complex(0.0, magnitude.GetX()[i] * 2.0 * M_PI);
-	}
+	threadCount = count;
+	threadPool.reset();
+}
+
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		GetThreadPool
+//
+// Description:		Returns the thread pool, creating it if necessary.  Pools
+//					are not created until needed, since many ExpressionTree
+//					objects are only used to compile expressions.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		ThreadPool&
+//
+//==========================================================================
+ThreadPool& ExpressionTree::GetThreadPool()
+{
+	if (!threadPool)
+		threadPool = std::make_unique<ThreadPool>(threadCount);
+	return *threadPool;
+}
 
-	phase = magnitude;
+//==========================================================================
+// Class:			ExpressionTree
+// Function:		GetChunkSize
+//
+// Description:		Chooses how many frequencies each thread solves at a time.
+//					Chunks are whole numbers of evaluation tiles, and small
+//					enough that each thread gets several, which balances the
+//					load when some threads are slowed by other work.
+//
+// Input Arguments:
+//		resolution	= const unsigned int& total number of frequencies
+//		threads		= const unsigned int& number of threads
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int ExpressionTree::GetChunkSize(const unsigned int &resolution, const unsigned int &threads)
+{
+	const unsigned int chunksPerThread(4);
+	const unsigned int tiles((resolution / (threads * chunksPerThread) +
+		EvaluationWorkspace::tileSize - 1) / EvaluationWorkspace::tileSize);
+	return std::max(minimumChunkSize, tiles * EvaluationWorkspace::tileSize);
 }
 
 //==========================================================================
@@ -250,8 +484,8 @@ void ExpressionTree::PrepareDataset(const double &minFreq, const double &maxFreq
 //					of operations.
 //
 // Input Arguments:
-//		operatorStack	= std::stack<wxString>&
-//		s				= const wxString& representing the next operator
+//		operatorStack	= std::stack<Token>&
+//		token			= const Token& representing the next operator
 //
 // Output Arguments:
 //		None
@@ -260,16 +494,16 @@ void ExpressionTree::PrepareDataset(const double &minFreq, const double &maxFreq
 //		None
 //
 //==========================================================================
-void ExpressionTree::ProcessOperator(std::stack<wxString> &operatorStack, const wxString &s)
+void ExpressionTree::ProcessOperator(std::stack<Token> &operatorStack, const Token &token)
 {
 	while (!operatorStack.empty())
 	{
-		if ((!NextIsOperator(operatorStack.top()) ||
-			!OperatorShift(operatorStack.top(), s)))
+		if (operatorStack.top().type != Token::Type::Operator ||
+			!OperatorShift(operatorStack.top().symbol, token.symbol))
 			break;
 		PopStackToQueue(operatorStack);
 	}
-	operatorStack.push(s);
+	operatorStack.push(token);
 }
 
 //==========================================================================
@@ -280,7 +514,7 @@ void ExpressionTree::ProcessOperator(std::stack<wxString> &operatorStack, const
 //					parenthese.
 //
 // Input Arguments:
-//		operatorStack	= std::stack<wxString>&
+//		operatorStack	= std::stack<Token>&
 //
 // Output Arguments:
 //		None
@@ -289,11 +523,11 @@ void ExpressionTree::ProcessOperator(std::stack<wxString> &operatorStack, const
 //		None
 //
 //==========================================================================
-void ExpressionTree::ProcessCloseParenthese(std::stack<wxString> &operatorStack)
+void ExpressionTree::ProcessCloseParenthese(std::stack<Token> &operatorStack)
 {
 	while (!operatorStack.empty())
 	{
-		if (operatorStack.top().Cmp(_T("(")) == 0)
+		if (operatorStack.top().type == Token::Type::OpenParenthese)
 			break;
 		PopStackToQueue(operatorStack);
 	}
@@ -310,212 +544,187 @@ void ExpressionTree::ProcessCloseParenthese(std::stack<wxString> &operatorStack)
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		EvaluateExpression
+// Function:		BuildProgram
 //
-// Description:		Evaluates the expression in the queue using Reverse Polish
-//					Notation.
+// Description:		Converts the Reverse Polish Notation queue into a program.
+//					Operand types are tracked so that any error that would
+//					otherwise occur during evaluation is reported here.  The
+//					instructions are then simplified into an ExpressionGraph,
+//					from which the program is built.
 //
 // Input Arguments:
-//		None
+//		expression	= const std::wstring_view&, the parsed expression
 //
 // Output Arguments:
-//		results	= Dataset2D&
+//		program		= CompiledExpression&
 //
 // Return Value:
 //		wxString containing a description of any errors, or wxEmptyString on success
 //
 //==========================================================================
-wxString ExpressionTree::EvaluateExpression()
+wxString ExpressionTree::BuildProgram(const std::wstring_view &expression, CompiledExpression &program)
 {
-	wxString next, errorString;
+	wxString errorString;
 
-	std::stack<double> doubleStack;
-	std::stack<std::vector<LibPlot2D::Complex>> vectorStack;
-	std::stack<bool> useDoubleStack;
+	std::vector<CompiledExpression::Instruction> instructions;
+	std::vector<bool> isScalarStack;
 
 	while (!outputQueue.empty())
 	{
-		next = outputQueue.front();
+		const Token next(outputQueue.front());
 		outputQueue.pop();
 
-		if (!EvaluateNext(next, doubleStack, vectorStack, useDoubleStack, errorString))
+		if (!CompileNext(expression, next, instructions, isScalarStack, errorString))
 			return errorString;
 	}
 
-	if (useDoubleStack.size() > 1)
+	if (isScalarStack.empty())
+		return _T("Empty expression!");
+	if (isScalarStack.size() > 1)
 		return _T("Not enough operators!");
-	if (useDoubleStack.top())
+	if (isScalarStack.back())
 		return _T("Expression evaluates to a number!");
+
+	const ExpressionGraph graph(instructions);
+	RationalFunction rationalForm;
+	if (ReduceToRationalFunction(graph, rationalForm))
+		program = CompiledExpression(graph, std::move(rationalForm));
 	else
-		dataVector = vectorStack.top();
+		program = CompiledExpression(graph);
 
 	return wxEmptyString;
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		PopStackToQueue
+// Function:		ReduceToRationalFunction
 //
-// Description:		Removes the top entry of the stack and puts it in the queue.
+// Description:		Attempts to expand the expression into a ratio of
+//					polynomials.  This is possible as long as every exponent
+//					applied to an expression involving s is a constant
+//					integer.  Each unique subexpression is expanded once.
+//					Exponents larger than maxRationalOrder are left to the
+//					step program, even when the base reduces to a constant.
 //
 // Input Arguments:
-//		stack	= std::stack<wxString>& to be popped
+//		graph	= const ExpressionGraph&
 //
 // Output Arguments:
-//		None
+//		result	= RationalFunction&
 //
 // Return Value:
-//		None
+//		bool, true if the expression was reduced, false otherwise
 //
 //==========================================================================
-void ExpressionTree::PopStackToQueue(std::stack<wxString> &stack)
+bool ExpressionTree::ReduceToRationalFunction(const ExpressionGraph &graph, RationalFunction &result) const
 {
-	outputQueue.push(stack.top());
-	stack.pop();
-}
+	std::vector<RationalFunction> terms(graph.GetNodeCount());
+	auto getTerm = [&graph, &terms](const unsigned int &i)
+	{
+		const ExpressionGraph::Node& node(graph.GetNode(i));
+		return node.IsConstant() ? RationalFunction(node.value) : terms[i];
+	};
 
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		EmptyStackToQueue
-//
-// Description:		Empties the contents of the stack into the queue.
-//
-// Input Arguments:
-//		stack	= std::stack<wxString>& to be emptied
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		bool, true for success, false otherwise (imbalance parentheses)
-//
-//==========================================================================
-bool ExpressionTree::EmptyStackToQueue(std::stack<wxString> &stack)
-{
-	while (!stack.empty())
+	for (const auto& i : graph.GetEvaluationOrder())
 	{
-		if (stack.top().Cmp(_T("(")) == 0)
-			return false;
-		PopStackToQueue(stack);
-	}
+		const ExpressionGraph::Node& node(graph.GetNode(i));
+		switch (node.code)
+		{
+		case CompiledExpression::OpCode::PushConstant:
+			continue;
 
-	return true;
-}
+		case CompiledExpression::OpCode::PushS:
+			terms[i] = RationalFunction(Polynomial::S(), Polynomial(1.0));
+			break;
 
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		NextIsNumber
-//
-// Description:		Determines if the next portion of the expression is a number.
-//
-// Input Arguments:
-//		s				= const wxString& containing the expression
-//		lastWasOperator	= const bool& indicating whether or not the last thing
-//						  on the stack is an operator
-//
-// Output Arguments:
-//		stop	= unsigned int* (optional) indicating length of number
-//
-// Return Value:
-//		bool, true if a number is next in the expression
-//
-//==========================================================================
-bool ExpressionTree::NextIsNumber(const wxString &s, unsigned int *stop,
-	const bool &lastWasOperator) const
-{
-	if (s.Len() == 0)
-		return false;
+		case CompiledExpression::OpCode::Negate:
+			terms[i] = -terms[node.first];
+			break;
 
-	bool foundDecimal = s[0] == '.';
-	if (foundDecimal ||
-		(int(s[0]) >= int('0') && int(s[0]) <= int('9')) ||
-		(s[0] == '-' && lastWasOperator && NextIsNumber(s.Mid(1), nullptr, false)))
-	{
-		unsigned int i;
-		for (i = 1; i < s.Len(); ++i)
+		case CompiledExpression::OpCode::Power:
 		{
-			if (s[i] == '.')
-			{
-				if (foundDecimal)
-					return false;
-				foundDecimal = true;
-			}
-			else if (int(s[i]) < int('0') || int(s[i]) > int('9'))
-				break;
+			const ExpressionGraph::Node& exponent(graph.GetNode(node.second));
+			if (!exponent.IsConstant() || !ExpressionGraph::IsInteger(exponent.value) ||
+				graph.GetNode(node.first).IsConstant() || fabs(exponent.value) > maxRationalOrder ||
+				fabs(exponent.value) * terms[node.first].GetOrder() > maxRationalOrder)
+				return false;
+			terms[i] = terms[node.first].ToPower(static_cast<int>(exponent.value));
+			break;
 		}
 
-		if (stop)
-			*stop = i;
-		return true;
+		case CompiledExpression::OpCode::Add:
+			terms[i] = getTerm(node.first) + getTerm(node.second);
+			break;
+
+		case CompiledExpression::OpCode::Subtract:
+			terms[i] = getTerm(node.first) - getTerm(node.second);
+			break;
+
+		case CompiledExpression::OpCode::Multiply:
+			terms[i] = getTerm(node.first) * getTerm(node.second);
+			break;
+
+		case CompiledExpression::OpCode::Divide:
+			terms[i] = getTerm(node.first) / getTerm(node.second);
+			break;
+		}
+
+		if (terms[i].GetOrder() > maxRationalOrder)
+			return false;
 	}
 
-	return false;
+	result = getTerm(graph.GetRoot());
+	return true;
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		NextIsOperator
+// Function:		PopStackToQueue
 //
-// Description:		Determines if the next portion of the expression is an operator.
+// Description:		Removes the top entry of the stack and puts it in the queue.
 //
 // Input Arguments:
-//		s		= const wxString& containing the expression
+//		stack	= std::stack<Token>& to be popped
 //
 // Output Arguments:
-//		stop	= unsigned int* (optional) indicating length of operator
+//		None
 //
 // Return Value:
-//		bool, true if an operator is next in the expression
+//		None
 //
 //==========================================================================
-bool ExpressionTree::NextIsOperator(const wxString &s, unsigned int *stop) const
+void ExpressionTree::PopStackToQueue(std::stack<Token> &stack)
 {
-	if (s.Len() == 0)
-		return false;
-
-	if (s[0] == '+' ||// From least precedence
-		s[0] == '-' ||
-		s[0] == '*' ||
-		s[0] == '/' ||
-		s[0] == '^')// To most precedence
-	{
-		if (stop)
-			*stop = 1;
-		return true;
-	}
-
-	return false;
+	outputQueue.push(stack.top());
+	stack.pop();
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		NextIsS
+// Function:		EmptyStackToQueue
 //
-// Description:		Determines if the next portion of the expression is "s" (or "S").
+// Description:		Empties the contents of the stack into the queue.
 //
 // Input Arguments:
-//		s		= const wxString& containing the expression
+//		stack	= std::stack<Token>& to be emptied
 //
 // Output Arguments:
-//		stop	= unsigned int* (optional) indicating length of operator
+//		None
 //
 // Return Value:
-//		bool, true if "s" is next in the expression
+//		bool, true for success, false otherwise (imbalance parentheses)
 //
 //==========================================================================
-bool ExpressionTree::NextIsS(const wxString &s, unsigned int *stop) const
+bool ExpressionTree::EmptyStackToQueue(std::stack<Token> &stack)
 {
-	if (s.Len() == 0)
-		return false;
-
-	if (s[0] == 's' || s[0] == 'S')
+	while (!stack.empty())
 	{
-		if (stop)
-			*stop = 1;
-		return true;
+		if (stack.top().type == Token::Type::OpenParenthese)
+			return false;
+		PopStackToQueue(stack);
 	}
 
-	return false;
+	return true;
 }
 
 //==========================================================================
@@ -526,8 +735,8 @@ bool ExpressionTree::NextIsS(const wxString &s, unsigned int *stop) const
 //					operator placement.
 //
 // Input Arguments:
-//		stackString	= const wxString& containing the expression
-//		newString	= const wxString& containing the expression
+//		stackOperator	= const wchar_t& on top of the operator stack
+//		newOperator		= const wchar_t& being added to the stack
 //
 // Output Arguments:
 //		None
@@ -536,15 +745,15 @@ bool ExpressionTree::NextIsS(const wxString &s, unsigned int *stop) const
 //		bool, true if shifting needs to occur
 //
 //==========================================================================
-bool ExpressionTree::OperatorShift(const wxString &stackString, const wxString &newString) const
+bool ExpressionTree::OperatorShift(const wchar_t &stackOperator, const wchar_t &newOperator) const
 {
-	unsigned int stackPrecedence = GetPrecedence(stackString);
-	unsigned int newPrecedence = GetPrecedence(newString);
+	unsigned int stackPrecedence = GetPrecedence(stackOperator);
+	unsigned int newPrecedence = GetPrecedence(newOperator);
 
 	if (stackPrecedence == 0 || newPrecedence == 0)
 		return false;
 
-	if (IsLeftAssociative(newString[0]))
+	if (IsLeftAssociative(newOperator))
 	{
 		if (newPrecedence <= stackPrecedence)
 			return true;
@@ -563,7 +772,7 @@ bool ExpressionTree::OperatorShift(const wxString &stackString, const wxString &
 //					(higher values are performed first)
 //
 // Input Arguments:
-//		s	= const wxString& containing the operator
+//		c	= const wchar_t& containing the operator
 //
 // Output Arguments:
 //		None
@@ -572,18 +781,15 @@ bool ExpressionTree::OperatorShift(const wxString &stackString, const wxString &
 //		unsigned int representing the precedence
 //
 //==========================================================================
-unsigned int ExpressionTree::GetPrecedence(const wxString &s) const
+unsigned int ExpressionTree::GetPrecedence(const wchar_t &c) const
 {
-	if (s.Len() != 1)
-		return 0;
-
-	if (s[0] == '+' ||
-		s[0] == '-')
+	if (c == '+' ||
+		c == '-')
 		return 2;
-	else if (s[0] == '*' ||
-		s[0] == '/')
+	else if (c == '*' ||
+		c == '/')
 		return 3;
-	else if (s[0] == '^')
+	else if (c == '^')
 		return 4;
 
 	return 0;
@@ -597,7 +803,7 @@ unsigned int ExpressionTree::GetPrecedence(const wxString &s) const
 //					associative.
 //
 // Input Arguments:
-//		c	= const wxChar&
+//		c	= const wchar_t&
 //
 // Output Arguments:
 //		None
@@ -606,7 +812,7 @@ unsigned int ExpressionTree::GetPrecedence(const wxString &s) const
 //		bool, true if left associative
 //
 //==========================================================================
-bool ExpressionTree::IsLeftAssociative(const wxChar &c) const
+bool ExpressionTree::IsLeftAssociative(const wchar_t &c) const
 {
 	switch (c)
 	{
@@ -620,269 +826,46 @@ bool ExpressionTree::IsLeftAssociative(const wxChar &c) const
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		PushToStack
-//
-// Description:		Pushes the specified value onto the stack.
-//
-// Input Arguments:
-//		value			= const double&
-//		doubleStack		= std::stack<double>&
-//		useDoubleStack	= std::stack<bool>&
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		None
-//
-//==========================================================================
-void ExpressionTree::PushToStack(const double &value, std::stack<double> &doubleStack,
-	std::stack<bool> &useDoubleStack) const
-{
-	doubleStack.push(value);
-	useDoubleStack.push(true);
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		PushToStack
-//
-// Description:		Pushes the specified dataset onto the stack.
-//
-// Input Arguments:
-//		vector			= const std::vector<LibPlot2D::Complex>&
-//		vectorStack		= std::stack<std::vector<LibPlot2D::Complex>>&
-//		useDoubleStack	= std::stack<bool>&
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		None
-//
-//==========================================================================
-void ExpressionTree::PushToStack(const std::vector<LibPlot2D::Complex> &vector, std::stack<std::vector<LibPlot2D::Complex>> &vectorStack,
-	std::stack<bool> &useDoubleStack) const
-{
-	vectorStack.push(vector);
-	useDoubleStack.push(false);
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		PopFromStack
-//
-// Description:		Pops the next value from the top of the appropriate stack.
-//
-// Input Arguments:
-//		doubleStack		= std::stack<double>&
-//		vectorStack		= std::stack<std::vector<LibPlot2D::Complex>>&
-//		useDoubleStack	= std::stack<bool>&
-//
-// Output Arguments:
-//		value			= double&
-//		vector			= std::vector<LibPlot2D::Complex>&
-//
-// Return Value:
-//		bool, true if a double was popped, false if a dataset was popped
-//
-//==========================================================================
-bool ExpressionTree::PopFromStack(std::stack<double> &doubleStack, std::stack<std::vector<LibPlot2D::Complex>> &vectorStack,
-	std::stack<bool> &useDoubleStack, double &value, std::vector<LibPlot2D::Complex> &vector) const
-{
-	assert(!useDoubleStack.empty());
-
-	bool useDouble = useDoubleStack.top();
-	useDoubleStack.pop();
-
-	if (useDouble)
-	{
-		assert(!doubleStack.empty());
-		value = doubleStack.top();
-		doubleStack.pop();
-	}
-	else
-	{
-		assert(!vectorStack.empty());
-		vector = vectorStack.top();
-		vectorStack.pop();
-	}
-
-	return useDouble;
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		ApplyOperation
-//
-// Description:		Applies the specified operation to the specified operands.
-//
-// Input Arguments:
-//		operation	= const wxString& describing the function to apply
-//		first		= const double&
-//		second		= const double&
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		double containing the result of the operation
-//
-//==========================================================================
-double ExpressionTree::ApplyOperation(const wxString &operation,
-	const double &first, const double &second) const
-{
-	if (operation.Cmp(_T("+")) == 0)
-		return second + first;
-	else if (operation.Cmp(_T("-")) == 0)
-		return second - first;
-	else if (operation.Cmp(_T("*")) == 0)
-		return second * first;
-	else if (operation.Cmp(_T("/")) == 0)
-		return second / first;
-	else if (operation.Cmp(_T("^")) == 0)
-		return pow(second, first);
-
-	assert(false);
-	return 0.0;
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		ApplyOperation
-//
-// Description:		Applies the specified operation to the specified operands.
-//
-// Input Arguments:
-//		operation	= const wxString& describing the function to apply
-//		first		= const const std::vector<LibPlot2D::Complex>&
-//		second		= const double&
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		double containing the result of the operation
-//
-//==========================================================================
-std::vector<LibPlot2D::Complex> ExpressionTree::ApplyOperation(const wxString &operation,
-	const std::vector<LibPlot2D::Complex> &first, const double &second) const
-{
-	std::vector<LibPlot2D::Complex> vector(first.size(), LibPlot2D::Complex(second, 0.0));
-	if (operation.Cmp(_T("+")) == 0)
-		return TFPMath::operator+<LibPlot2D::Complex>(vector, first);
-	else if (operation.Cmp(_T("-")) == 0)
-		return TFPMath::operator-<LibPlot2D::Complex>(vector, first);
-	else if (operation.Cmp(_T("*")) == 0)
-		return TFPMath::operator*<LibPlot2D::Complex>(vector, first);
-	else if (operation.Cmp(_T("/")) == 0)
-		return TFPMath::operator/<LibPlot2D::Complex>(vector, first);
-	else if (operation.Cmp(_T("^")) == 0)
-	{
-		std::vector<LibPlot2D::Complex> result(first.size());
-		for (unsigned int i = 0; i < result.size(); ++i)
-			result[i] = vector[i].ToPower(first[i]);
-		return result;
-	}
-
-	assert(false);
-	return vector;
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		ApplyOperation
-//
-// Description:		Applies the specified operation to the specified operands.
-//
-// Input Arguments:
-//		operation	= const wxString& describing the function to apply
-//		first		= const double&
-//		second		= const std::vector<LibPlot2D::Complex>&
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		double containing the result of the operation
-//
-//==========================================================================
-std::vector<LibPlot2D::Complex> ExpressionTree::ApplyOperation(const wxString &operation,
-	const double &first, const std::vector<LibPlot2D::Complex> &second) const
-{
-	std::vector<LibPlot2D::Complex> vector(second.size(), LibPlot2D::Complex(first, 0.0));
-	if (operation.Cmp(_T("+")) == 0)
-		return TFPMath::operator+<LibPlot2D::Complex>(second, vector);
-	else if (operation.Cmp(_T("-")) == 0)
-		return TFPMath::operator-<LibPlot2D::Complex>(second, vector);
-	else if (operation.Cmp(_T("*")) == 0)
-		return TFPMath::operator*<LibPlot2D::Complex>(second, vector);
-	else if (operation.Cmp(_T("/")) == 0)
-		return TFPMath::operator/<LibPlot2D::Complex>(second, vector);
-	else if (operation.Cmp(_T("^")) == 0)
-	{
-		std::vector<LibPlot2D::Complex> result(second.size());
-		for (unsigned int i = 0; i < result.size(); ++i)
-			result[i] = second[i].ToPower(vector[i]);
-		return result;
-	}
-
-	assert(false);
-	return vector;
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		ApplyOperation
+// Function:		GetOpCode
 //
-// Description:		Applies the specified operation to the specified operands.
+// Description:		Returns the op code corresponding to the specified binary
+//					operator.
 //
 // Input Arguments:
-//		operation	= const wxString& describing the function to apply
-//		first		= const const std::vector<LibPlot2D::Complex>&
-//		second		= const const std::vector<LibPlot2D::Complex>&
+//		operation	= const wchar_t&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		double containing the result of the operation
+//		CompiledExpression::OpCode
 //
 //==========================================================================
-std::vector<LibPlot2D::Complex> ExpressionTree::ApplyOperation(const wxString &operation,
-	const std::vector<LibPlot2D::Complex> &first, const std::vector<LibPlot2D::Complex> &second) const
+CompiledExpression::OpCode ExpressionTree::GetOpCode(const wchar_t &operation)
 {
-	if (operation.Cmp(_T("+")) == 0)
-		return TFPMath::operator+<LibPlot2D::Complex>(second, first);
-	else if (operation.Cmp(_T("-")) == 0)
-		return TFPMath::operator-<LibPlot2D::Complex>(second, first);
-	else if (operation.Cmp(_T("*")) == 0)
-		return TFPMath::operator*<LibPlot2D::Complex>(second, first);
-	else if (operation.Cmp(_T("/")) == 0)
-		return TFPMath::operator/<LibPlot2D::Complex>(second, first);
-	else if (operation.Cmp(_T("^")) == 0)
-	{
-		std::vector<LibPlot2D::Complex> result(first.size());
-		for (unsigned int i = 0; i < result.size(); ++i)
-			result[i] = second[i].ToPower(first[i]);
-		return result;
-	}
-
-	assert(false);
-	return first;
+	if (operation == '+')
+		return CompiledExpression::OpCode::Add;
+	else if (operation == '-')
+		return CompiledExpression::OpCode::Subtract;
+	else if (operation == '*')
+		return CompiledExpression::OpCode::Multiply;
+	else if (operation == '/')
+		return CompiledExpression::OpCode::Divide;
+
+	assert(operation == '^');
+	return CompiledExpression::OpCode::Power;
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		EvaluateOperator
+// Function:		CompileOperator
 //
-// Description:		Evaluates the operator specified.
+// Description:		Adds the instruction for the specified operator.
 //
 // Input Arguments:
-//		operator		= const wxString& describing the function to apply
-//		doubleStack		= std::stack<double>&
-//		vectorStack		= std::stack<std::vector<Complex>>&
-//		useDoubleStack	= std::stack<bool>&
+//		operation		= const wchar_t& describing the function to apply
+//		instructions	= std::vector<CompiledExpression::Instruction>&
+//		isScalarStack	= std::vector<bool>&
 //
 // Output Arguments:
 //		errorString		= wxString&
@@ -891,77 +874,41 @@ std::vector<LibPlot2D::Complex> ExpressionTree::ApplyOperation(const wxString &o
 //		bool, true for success, false otherwise
 //
 //==========================================================================
-bool ExpressionTree::EvaluateOperator(const wxString &operation, std::stack<double> &doubleStack,
-	std::stack<std::vector<LibPlot2D::Complex>> &vectorStack, std::stack<bool> &useDoubleStack, wxString &errorString) const
+bool ExpressionTree::CompileOperator(const wchar_t &operation,
+	std::vector<CompiledExpression::Instruction> &instructions,
+	std::vector<bool> &isScalarStack, wxString &errorString) const
 {
-	double value1, value2;
-	std::vector<LibPlot2D::Complex> vector1, vector2;
-
-	if (useDoubleStack.size() < 2)
-		return EvaluateUnaryOperator(operation, doubleStack, vectorStack, useDoubleStack, errorString);
-	else if (PopFromStack(doubleStack, vectorStack, useDoubleStack, value1, vector1))
+	// The only unary operator we recognize is minus (negation)
+	if (isScalarStack.size() < 2)
 	{
-		if (PopFromStack(doubleStack, vectorStack, useDoubleStack, value2, vector2))
-			PushToStack(ApplyOperation(operation, value1, value2), doubleStack, useDoubleStack);
-		else
-			PushToStack(ApplyOperation(operation, value1, vector2), vectorStack, useDoubleStack);
-	}
-	else if (PopFromStack(doubleStack, vectorStack, useDoubleStack, value2, vector2))
-		PushToStack(ApplyOperation(operation, vector1, value2), vectorStack, useDoubleStack);
-	else
-		PushToStack(ApplyOperation(operation, vector1, vector2), vectorStack, useDoubleStack);
-	return true;
-}
+		if (operation != '-' || isScalarStack.empty())
+		{
+			errorString = _T("Attempting to apply operator without two operands!");
+			return false;
+		}
 
-//=============================================================================
-// Class:			ExpressionTree
-// Function:		EvaluateUnaryOperator
-//
-// Description:		Evaluates the operator specified.  The only unary operator
-//					we recognize is minus (negation).
-//
-// Input Arguments:
-//		operator		= const wxString& describing the function to apply
-//		doubleStack		= std::stack<double>&
-//		vectorStack		= std::stack<std::vector<LibPlot2D::Complex>>&
-//		useDoubleStack	= std::stack<bool>&
-//
-// Output Arguments:
-//		errorString		= wxString&
-//
-// Return Value:
-//		bool, true for success, false otherwise
-//
-//=============================================================================
-bool ExpressionTree::EvaluateUnaryOperator(const wxString &operation, std::stack<double> &doubleStack,
-	std::stack<std::vector<LibPlot2D::Complex>> &vectorStack, std::stack<bool> &useDoubleStack, wxString &errorString) const
-{
-	if (operation.Cmp(_T("-")) != 0)
-	{
-		errorString = _T("Attempting to apply operator without two operands!");
-		return false;
+		instructions.push_back(CompiledExpression::Instruction(CompiledExpression::OpCode::Negate));
+		return true;
 	}
 
-	double value;
-	std::vector<LibPlot2D::Complex> vector;
-	if (PopFromStack(doubleStack, vectorStack, useDoubleStack, value, vector))
-		PushToStack(ApplyOperation(_T("*"), -1.0, value), doubleStack, useDoubleStack);
-	else
-		PushToStack(ApplyOperation(_T("*"), -1.0, vector), vectorStack, useDoubleStack);
+	const bool isScalar(isScalarStack.back() && isScalarStack[isScalarStack.size() - 2]);
+	isScalarStack.pop_back();
+	isScalarStack.back() = isScalar;
 
+	instructions.push_back(CompiledExpression::Instruction(GetOpCode(operation)));
 	return true;
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		EvaluateNumber
+// Function:		CompileNumber
 //
-// Description:		Evaluates the number specified.
+// Description:		Adds the instruction for the number specified.
 //
 // Input Arguments:
-//		number			= const wxString& describing the number
-//		doubleStack		= std::stack<double>&
-//		useDoubleStack	= std::stack<bool>&
+//		number			= const std::wstring_view& describing the number
+//		instructions	= std::vector<CompiledExpression::Instruction>&
+//		isScalarStack	= std::vector<bool>&
 //
 // Output Arguments:
 //		errorString		= wxString&
@@ -970,59 +917,39 @@ bool ExpressionTree::EvaluateUnaryOperator(const wxString &operation, std::stack
 //		bool, true for success, false otherwise
 //
 //==========================================================================
-bool ExpressionTree::EvaluateNumber(const wxString &number, std::stack<double> &doubleStack,
-	std::stack<bool> &useDoubleStack, wxString &errorString) const
+bool ExpressionTree::CompileNumber(const std::wstring_view &number,
+	std::vector<CompiledExpression::Instruction> &instructions,
+	std::vector<bool> &isScalarStack, wxString &errorString) const
 {
-	double value;
+	// The number is followed by a character that cannot continue it, so
+	// conversion stops at the end of the token without copying it
+	wchar_t *end;
+	const double value(std::wcstod(number.data(), &end));
 
-	if (!number.ToDouble(&value))
+	if (end != number.data() + number.length())
 	{
-		errorString = _T("Could not convert ") + number + _T(" to a number.");
+		errorString = _T("Could not convert ") + wxString(number.data(), number.length()) + _T(" to a number.");
 		return false;
 	}
 
-	PushToStack(value, doubleStack, useDoubleStack);
-
-	return true;
-}
-
-//==========================================================================
-// Class:			ExpressionTree
-// Function:		EvaluateS
-//
-// Description:		Evaluates the frequency specified.
-//
-// Input Arguments:
-//		vectorStack		= std::stack<std::vector<LibPlot2D::Complex>>&
-//		useDoubleStack	= std::stack<bool>&
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		bool, true for success, false otherwise
-//
-//==========================================================================
-bool ExpressionTree::EvaluateS(std::stack<std::vector<LibPlot2D::Complex>> &vectorStack,
-	std::stack<bool> &useDoubleStack) const
-{
-	PushToStack(dataVector, vectorStack, useDoubleStack);
+	instructions.push_back(CompiledExpression::Instruction(CompiledExpression::OpCode::PushConstant, value));
+	isScalarStack.push_back(true);
 
 	return true;
 }
 
 //==========================================================================
 // Class:			ExpressionTree
-// Function:		EvaluateNext
+// Function:		CompileNext
 //
-// Description:		Determines how to evaluate the specified term and takes
+// Description:		Determines how to compile the specified term and takes
 //					appropriate action.
 //
 // Input Arguments:
-//		next			= const wxString&
-//		doubleStack		= std::stack<double>&
-//		vectorStack		= std::stack<std::vector<LibPlot2D::Complex>>&
-//		useDoubleStack	= std::stack<bool>&
+//		expression		= const std::wstring_view&, the parsed expression
+//		next			= const Token&
+//		instructions	= std::vector<CompiledExpression::Instruction>&
+//		isScalarStack	= std::vector<bool>&
 //
 // Output Arguments:
 //		errorString	= wxString&
@@ -1031,17 +958,24 @@ bool ExpressionTree::EvaluateS(std::stack<std::vector<LibPlot2D::Complex>> &vect
 //		bool, true for valid operation, false otherwise
 //
 //==========================================================================
-bool ExpressionTree::EvaluateNext(const wxString &next, std::stack<double> &doubleStack,
-		std::stack<std::vector<LibPlot2D::Complex>> &vectorStack, std::stack<bool> &useDoubleStack, wxString &errorString) const
+bool ExpressionTree::CompileNext(const std::wstring_view &expression, const Token &next,
+	std::vector<CompiledExpression::Instruction> &instructions,
+	std::vector<bool> &isScalarStack, wxString &errorString) const
 {
-	if (NextIsNumber(next))
-		return EvaluateNumber(next, doubleStack, useDoubleStack, errorString);
-	if (NextIsOperator(next))
-		return EvaluateOperator(next, doubleStack, vectorStack, useDoubleStack, errorString);
-	if (NextIsS(next))
-		return EvaluateS(vectorStack, useDoubleStack);
+	if (next.type == Token::Type::Number)
+		return CompileNumber(expression.substr(next.offset, next.length),
+			instructions, isScalarStack, errorString);
+	if (next.type == Token::Type::Operator)
+		return CompileOperator(next.symbol, instructions, isScalarStack, errorString);
+	if (next.type == Token::Type::S)
+	{
+		instructions.push_back(CompiledExpression::Instruction(CompiledExpression::OpCode::PushS));
+		isScalarStack.push_back(false);
+		return true;
+	}
 	else
-		errorString = _T("Unable to evaluate '") + next + _T("'.");
+		errorString = _T("Unable to evaluate '") +
+			wxString(expression.data() + next.offset, next.length) + _T("'.");
 
 	return false;
 }
@@ -15,6 +15,12 @@
 #ifndef _EXPRESSION_TREE_H_
 #define _EXPRESSION_TREE_H_
 
+// Local headers
+#include "compiledExpression.h"
+#include "threadPool.h"
+#include "expressionLexer.h"
+#include "frequencyGrid.h"
+
 // LibPlot2D headers
 #include <lp2d/utilities/managedList.h>
 #include <lp2d/utilities/dataset2D.h>
@@ -26,67 +32,98 @@
 // Standard C++ headers
 #include <queue>
 #include <stack>
+#include <memory>
+#include <string_view>
+#include <atomic>
+
+// Local forward declarations
+class ExpressionGraph;
 
+// An instance holds parsing and solving buffers, so it must only be used by one
+// thread at a time.  To evaluate from several threads, share the compiled program
+// and give each thread its own EvaluationWorkspace.
 class ExpressionTree
 {
 public:
-	// Main solver method
+	// Main solver methods
 	wxString Solve(wxString expression, const double &minFreq, const double &maxFreq,
 		const unsigned int &resolution, LibPlot2D::Dataset2D &magnitude, LibPlot2D::Dataset2D &phase);
+	void Solve(const CompiledExpression &program, const double &minFreq, const double &maxFreq,
+		const unsigned int &resolution, LibPlot2D::Dataset2D &magnitude, LibPlot2D::Dataset2D &phase);
+	// If cancel is set while solving, remaining tiles are skipped and the
+	// output is incomplete
+	void Solve(const CompiledExpression &program, const FrequencyGrid &grid,
+		std::vector<double> &magnitude, std::vector<double> &phase,
+		const std::atomic<bool> *cancel = nullptr);
+
+	// Solves several programs at once.  Chunks from all programs are shared
+	// among the threads, so the load stays balanced when the programs differ
+	// in cost or each has too few frequencies to occupy every thread.
+	// Tasks may use different grids.
+	struct SolveTask
+	{
+		const CompiledExpression *program;
+		const FrequencyGrid *grid;
+		std::vector<double> *magnitude;// [dB]
+		std::vector<double> *phase;// [deg]
+	};
+
+	void Solve(const std::vector<SolveTask> &tasks, const std::atomic<bool> *cancel = nullptr);
+
+	wxString Compile(wxString expression, CompiledExpression &program);
+
+	// Number of threads used by Solve(); zero for one per hardware thread.
+	// Results do not depend on the number of threads.
+	void SetThreadCount(const unsigned int &count);
+	unsigned int GetThreadCount() const { return threadCount; }
 
 	wxString CheckExpression(wxString expression);
 
 private:
-	std::queue<wxString> outputQueue;
-	std::vector<LibPlot2D::Complex> dataVector;
+	typedef ExpressionLexer::Token Token;
+	std::queue<Token> outputQueue;
 
-	void PrepareDataset(const double &minFreq, const double &maxFreq,
-		const unsigned int &resolution, LibPlot2D::Dataset2D &magnitude, LibPlot2D::Dataset2D &phase);
+	// Reused between solves to avoid allocating, one workspace per thread
+	std::vector<EvaluationWorkspace> workspaces;
+	ComplexVector response;
+	std::vector<ComplexVector> taskResponses;// One per task
+	std::vector<unsigned int> taskChunks;// Index of each task's first chunk
+
+	unsigned int threadCount = 0;
+	std::unique_ptr<ThreadPool> threadPool;// Created on first use
+	ThreadPool& GetThreadPool();
+
+	static const unsigned int minimumChunkSize;
+	static unsigned int GetChunkSize(const unsigned int &resolution, const unsigned int &threads);
+
+	wxString ParseExpression(const std::wstring_view &expression);
+	void ParseNext(const Token &token, bool &lastWasOperator, std::stack<Token> &operatorStack);
+
+	void ProcessOperator(std::stack<Token> &operatorStack, const Token &token);
+	void ProcessCloseParenthese(std::stack<Token> &operatorStack);
+
+	bool IsLeftAssociative(const wchar_t &c) const;
+	bool OperatorShift(const wchar_t &stackOperator, const wchar_t &newOperator) const;
+
+	void PopStackToQueue(std::stack<Token> &stack);
+	bool EmptyStackToQueue(std::stack<Token> &stack);
+	unsigned int GetPrecedence(const wchar_t &c) const;
+
+	wxString BuildProgram(const std::wstring_view &expression, CompiledExpression &program);
+	bool CompileNext(const std::wstring_view &expression, const Token &next,
+		std::vector<CompiledExpression::Instruction> &instructions,
+		std::vector<bool> &isScalarStack, wxString &errorString) const;
+	bool CompileOperator(const wchar_t &operation, std::vector<CompiledExpression::Instruction> &instructions,
+		std::vector<bool> &isScalarStack, wxString &errorString) const;
+	bool CompileNumber(const std::wstring_view &number, std::vector<CompiledExpression::Instruction> &instructions,
+		std::vector<bool> &isScalarStack, wxString &errorString) const;
+
+	static CompiledExpression::OpCode GetOpCode(const wchar_t &operation);
+
+	static const unsigned int maxRationalOrder;
+	bool ReduceToRationalFunction(const ExpressionGraph &graph, RationalFunction &result) const;
 
-	wxString ParseExpression(const wxString &expression);
-	wxString ParseNext(const wxString &expression, bool &lastWasOperator,
-		unsigned int &advance, std::stack<wxString> &operatorStack);
-	wxString EvaluateExpression();
-
-	void ProcessOperator(std::stack<wxString> &operatorStack, const wxString &s);
-	void ProcessCloseParenthese(std::stack<wxString> &operatorStack);
-
-	bool NextIsNumber(const wxString &s, unsigned int *stop = nullptr, const bool &lastWasOperator = true) const;
-	bool NextIsOperator(const wxString &s, unsigned int *stop = nullptr) const;
-	bool NextIsS(const wxString &s, unsigned int *stop = nullptr) const;
-
-	bool IsLeftAssociative(const wxChar &c) const;
-	bool OperatorShift(const wxString &stackString, const wxString &newString) const;
-
-	void PopStackToQueue(std::stack<wxString> &stack);
-	bool EmptyStackToQueue(std::stack<wxString> &stack);
-	unsigned int GetPrecedence(const wxString &s) const;
-
-	void PushToStack(const double &value, std::stack<double> &doubleStack,
-		std::stack<bool> &useDoubleStack) const;
-	void PushToStack(const std::vector<LibPlot2D::Complex> &vector, std::stack<std::vector<LibPlot2D::Complex>> &vectorStack,
-		std::stack<bool> &useDoubleStack) const;
-	bool PopFromStack(std::stack<double> &doubleStack, std::stack<std::vector<LibPlot2D::Complex>> &vectorStack,
-		std::stack<bool> &useDoubleStack, double &value, std::vector<LibPlot2D::Complex> &vector) const;
-
-	double ApplyOperation(const wxString &operation, const double &first, const double &second) const;
-	std::vector<LibPlot2D::Complex> ApplyOperation(const wxString &operation, const std::vector<LibPlot2D::Complex> &first, const double &second) const;
-	std::vector<LibPlot2D::Complex> ApplyOperation(const wxString &operation, const double &first, const std::vector<LibPlot2D::Complex> &second) const;
-	std::vector<LibPlot2D::Complex> ApplyOperation(const wxString &operation, const std::vector<LibPlot2D::Complex> &first,
-		const std::vector<LibPlot2D::Complex> &second) const;
-
-	bool EvaluateNext(const wxString &next, std::stack<double> &doubleStack,
-		std::stack<std::vector<LibPlot2D::Complex>> &vectorStack, std::stack<bool> &useDoubleStack, wxString &errorString) const;
-	bool EvaluateOperator(const wxString &operation, std::stack<double> &doubleStack,
-		std::stack<std::vector<LibPlot2D::Complex>> &vectorStack, std::stack<bool> &useDoubleStack, wxString &errorString) const;
-	bool EvaluateUnaryOperator(const wxString &operation, std::stack<double> &doubleStack,
-		std::stack<std::vector<LibPlot2D::Complex>> &vectorStack, std::stack<bool> &useDoubleStack, wxString &errorString) const;
-	bool EvaluateNumber(const wxString &number, std::stack<double> &doubleStack,
-		std::stack<bool> &useDoubleStack, wxString &errorString) const;
-	bool EvaluateS(std::stack<std::vector<LibPlot2D::Complex>> &vectorStack,
-		std::stack<bool> &useDoubleStack) const;
-
-	bool ParenthesesBalanced(const wxString &expression) const;
+	bool ParenthesesBalanced(const std::wstring_view &expression) const;
 };
 
 #endif// _EXPRESSION_TREE_H_
@@ -0,0 +1,146 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  frequencyGrid.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Frequencies at which transfer functions are evaluated, either spaced
+//				 logarithmically or chosen by the caller.  Grids are immutable, so one
+//				 grid can be shared by every response computed on it.  Low powers of
+//				 the angular frequency are computed with the grid, so evaluating
+//				 s = j * omega and its powers needs no work per solve.
+
+// Local headers
+#include "frequencyGrid.h"
+
+// Standard C++ headers
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+//==========================================================================
+// Class:			FrequencyGrid
+// Function:		maximumCachedPower
+//
+// Description:		Highest power of the angular frequency stored with each
+//					grid.
+//
+//==========================================================================
+const unsigned int FrequencyGrid::maximumCachedPower(4);
+
+//==========================================================================
+// Class:			FrequencyGrid
+// Function:		FrequencyGrid
+//
+// Description:		Constructor for FrequencyGrid class.  Points are found in
+//					blocks; the first point of each block is computed directly
+//					from its index, and the others by multiplying it by powers
+//					of the ratio between points.  Error does not accumulate
+//					from one block to the next, and the ends are exact.
+//
+// Input Arguments:
+//		minFreq		= const double& [Hz]
+//		maxFreq		= const double& [Hz]
+//		resolution	= const unsigned int& number of frequencies
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+FrequencyGrid::FrequencyGrid(const double &minFreq, const double &maxFreq,
+	const unsigned int &resolution) : minFreq(minFreq), maxFreq(maxFreq), frequencies(resolution)
+{
+	if (resolution < 2)
+	{
+		std::fill(frequencies.begin(), frequencies.end(), minFreq);
+		ComputeAngularFrequencyPowers();
+		return;
+	}
+
+	const double logMin(log10(minFreq));
+	const double logStep(log10(maxFreq / minFreq) / (resolution - 1));
+
+	const unsigned int blockSize(std::min(resolution, 64U));
+	std::vector<double> ratios(blockSize);
+	for (unsigned int i = 0; i < blockSize; ++i)
+		ratios[i] = pow(10.0, i * logStep);
+
+	for (unsigned int start = 0; start < resolution; start += blockSize)
+	{
+		const double first(pow(10.0, start * logStep + logMin));
+		const unsigned int count(std::min(blockSize, resolution - start));
+		for (unsigned int i = 0; i < count; ++i)
+			frequencies[start + i] = first * ratios[i];
+	}
+
+	frequencies.front() = minFreq;
+	frequencies.back() = maxFreq;
+	ComputeAngularFrequencyPowers();
+}
+
+//==========================================================================
+// Class:			FrequencyGrid
+// Function:		FrequencyGrid
+//
+// Description:		Constructor for FrequencyGrid class, for grids with
+//					arbitrary spacing.
+//
+// Input Arguments:
+//		frequencies	= std::vector<double>, increasing [Hz]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+FrequencyGrid::FrequencyGrid(std::vector<double> frequencies) : minFreq(frequencies.front()),
+	maxFreq(frequencies.back()), frequencies(std::move(frequencies))
+{
+	assert(std::is_sorted(this->frequencies.begin(), this->frequencies.end()));
+	ComputeAngularFrequencyPowers();
+}
+
+//==========================================================================
+// Class:			FrequencyGrid
+// Function:		ComputeAngularFrequencyPowers
+//
+// Description:		Fills the cached powers of the angular frequency.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void FrequencyGrid::ComputeAngularFrequencyPowers()
+{
+	angularFrequencyPowers.resize(maximumCachedPower);
+
+	std::vector<double>& omega(angularFrequencyPowers.front());
+	omega.resize(frequencies.size());
+	for (unsigned int i = 0; i < frequencies.size(); ++i)
+		omega[i] = frequencies[i] * 2.0 * M_PI;
+
+	for (unsigned int power = 1; power < maximumCachedPower; ++power)
+	{
+		const std::vector<double>& previous(angularFrequencyPowers[power - 1]);
+		angularFrequencyPowers[power].resize(frequencies.size());
+		for (unsigned int i = 0; i < frequencies.size(); ++i)
+			angularFrequencyPowers[power][i] = previous[i] * omega[i];
+	}
+}
@@ -0,0 +1,53 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  frequencyGrid.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Frequencies at which transfer functions are evaluated, either spaced
+//				 logarithmically or chosen by the caller.  Grids are immutable, so one
+//				 grid can be shared by every response computed on it.  Low powers of
+//				 the angular frequency are computed with the grid, so evaluating
+//				 s = j * omega and its powers needs no work per solve.
+
+#ifndef _FREQUENCY_GRID_H_
+#define _FREQUENCY_GRID_H_
+
+// Standard C++ headers
+#include <vector>
+
+class FrequencyGrid
+{
+public:
+	// Frequencies are in [Hz]
+	FrequencyGrid(const double &minFreq, const double &maxFreq, const unsigned int &resolution);
+	explicit FrequencyGrid(std::vector<double> frequencies);// Increasing, at least one
+
+	double GetMinimum() const { return minFreq; }
+	double GetMaximum() const { return maxFreq; }
+	unsigned int GetSize() const { return static_cast<unsigned int>(frequencies.size()); }
+
+	const std::vector<double>& GetFrequencies() const { return frequencies; }// [Hz]
+
+	// omega^power, for powers from one to maximumCachedPower, where
+	// omega = 2 * pi * f [rad/sec]
+	static const unsigned int maximumCachedPower;
+	const std::vector<double>& GetAngularFrequencies() const { return angularFrequencyPowers.front(); }
+	const std::vector<double>& GetAngularFrequencyPower(const unsigned int &power) const { return angularFrequencyPowers[power - 1]; }
+
+private:
+	const double minFreq;
+	const double maxFreq;
+	std::vector<double> frequencies;
+	std::vector<std::vector<double>> angularFrequencyPowers;
+
+	void ComputeAngularFrequencyPowers();
+};
+
+#endif// _FREQUENCY_GRID_H_
@@ -17,6 +17,8 @@
 #include "mainFrame.h"
 #include "plotterApp.h"
 #include "tfDialog.h"
+#include "threadPool.h"
+#include "curveDecimator.h"
 
 // LibPlot2D headers
 #include <lp2d/renderer/plotRenderer.h>
@@ -26,6 +28,7 @@
 #include <wx/grid.h>
 #include <wx/colordlg.h>
 #include <wx/splitter.h>
+#include <wx/spinctrl.h>
 
 // Standard C++ headers
 #include <algorithm>
@@ -60,10 +63,17 @@
 //==========================================================================
 MainFrame::MainFrame() : wxFrame(nullptr, wxID_ANY, wxEmptyString, wxDefaultPosition,
 	wxDefaultSize, wxDEFAULT_FRAME_STYLE), individualAmplitudeInterface(this),
-	individualPhaseInterface(this), totalAmplitudeInterface(this), totalPhaseInterface(this)
+	individualPhaseInterface(this), totalAmplitudeInterface(this), totalPhaseInterface(this),
+	plottedHertz(true), viewTimer(this, idViewTimer), plotViews(plotCount), zoomedPlot(0)
 {
 	CreateControls();
 	SetProperties();
+
+	// Called from the solver's worker thread
+	dataManager.SetSolveCompleteCallback([this]()
+	{
+		wxQueueEvent(this, new wxThreadEvent(wxEVT_THREAD, idSolveComplete));
+	});
 }
 
 //==========================================================================
@@ -152,6 +162,8 @@ LibPlot2D::PlotRenderer* MainFrame::CreatePlotArea(wxWindow *parent, LibPlot2D::
 	plotArea->SetTitle(title);
 	plotArea->SetLeftYLabel(yLabel);
 
+	plotArea->Connect(wxEVT_PAINT, wxPaintEventHandler(MainFrame::PlotPaintEvent), nullptr, this);
+
 	return plotArea;
 }
 
@@ -238,8 +250,27 @@ wxSizer* MainFrame::CreateInputControls(wxWindow *parent)
 	gridSizer->Add(maxFreqLabel);
 	gridSizer->Add(maxFrequencyTextBox);
 
+	// Results do not depend on the number of threads, so changing it does not re-solve
+	const unsigned int hardwareThreads(ThreadPool::GetHardwareThreadCount());
+	wxStaticText *threadCountLabel = new wxStaticText(parent, wxID_ANY, _T("Threads"));
+	threadCountSpinCtrl = new wxSpinCtrl(parent, idThreadCount, wxEmptyString,
+		wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 4 * hardwareThreads, hardwareThreads);
+	dataManager.SetThreadCount(hardwareThreads);
+	gridSizer->Add(threadCountLabel);
+	gridSizer->Add(threadCountSpinCtrl);
+
+	wxStaticText *resolutionLabel = new wxStaticText(parent, wxID_ANY, _T("Points"));
+	resolutionSpinCtrl = new wxSpinCtrl(parent, idResolution, wxEmptyString,
+		wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 2, 100000000, dataManager.GetResolution());
+	gridSizer->Add(resolutionLabel);
+	gridSizer->Add(resolutionSpinCtrl);
+
 	sizer->Add(gridSizer, 0, wxALL, 2);
 
+	adaptiveSamplingCheckBox = new wxCheckBox(parent, idAdaptiveSampling, _T("Adaptive Sampling"));
+	adaptiveSamplingCheckBox->SetValue(dataManager.GetAdaptiveSampling());
+	sizer->Add(adaptiveSamplingCheckBox, 0, wxALL, 2);
+
 	return sizer;
 }
 
@@ -273,6 +304,7 @@ wxGrid* MainFrame::CreateOptionsGrid(wxWindow *parent)
 	optionsGrid->SetColFormatFloat(colDifference);
 	optionsGrid->SetColFormatBool(colVisible);
 	optionsGrid->SetColFormatBool(colRightAxis);
+	optionsGrid->SetColFormatNumber(colResolution);
 
 	optionsGrid->SetColLabelValue(colName, _T("Curve"));
 	optionsGrid->SetColLabelValue(colColor, _T("Color"));
@@ -282,6 +314,7 @@ wxGrid* MainFrame::CreateOptionsGrid(wxWindow *parent)
 	optionsGrid->SetColLabelValue(colDifference, _T("Difference"));
 	optionsGrid->SetColLabelValue(colVisible, _T("Visible"));
 	optionsGrid->SetColLabelValue(colRightAxis, _T("Right Axis"));
+	optionsGrid->SetColLabelValue(colResolution, _T("Points"));
 
 	optionsGrid->SetColLabelAlignment(wxALIGN_CENTER, wxALIGN_CENTER);
 	optionsGrid->SetDefaultCellAlignment(wxALIGN_CENTER, wxALIGN_CENTER);
@@ -354,6 +387,12 @@ BEGIN_EVENT_TABLE(MainFrame, wxFrame)
 	EVT_BUTTON(idRemoveAllButton,					MainFrame::RemoveAllButtonClicked)
 
 	EVT_RADIOBUTTON(wxID_ANY,						MainFrame::RadioButtonChangeEvent)
+	EVT_SPINCTRL(idThreadCount,						MainFrame::ThreadCountChangeEvent)
+	EVT_SPINCTRL(idResolution,						MainFrame::ResolutionChangeEvent)
+	EVT_CHECKBOX(idAdaptiveSampling,					MainFrame::AdaptiveSamplingChangeEvent)
+
+	EVT_THREAD(idSolveComplete,						MainFrame::SolveCompleteEvent)
+	EVT_TIMER(idViewTimer,							MainFrame::ViewTimerEvent)
 
 	// Grid control
 	EVT_GRID_CELL_RIGHT_CLICK(MainFrame::GridRightClickEvent)
@@ -536,6 +575,9 @@ void MainFrame::ClearAllCurves()
 	totalAmplitudeInterface.ClearAllCurves();
 	totalPhaseInterface.ClearAllCurves();
 
+	plottedCurves.clear();
+	plottedTotal = PlottedCurve();
+
 	UpdatePlotDisplays();
 }
 
@@ -564,19 +606,10 @@ void MainFrame::AddCurve(wxString numerator, wxString denominator)
 	optionsGrid->BeginBatch();
 	if (optionsGrid->GetNumberRows() == 0)
 		AddXRowToGrid();
-	unsigned int index = AddDataRowToGrid("(" + numerator + ")/(" + denominator + ")");
+	AddDataRowToGrid("(" + numerator + ")/(" + denominator + ")");
 	optionsGrid->EndBatch();
 
-	totalAmplitudeInterface.ClearAllCurves();
-	totalPhaseInterface.ClearAllCurves();
-
-	totalAmplitudeInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetTotalAmplitudeData()), _T("Total Amplitude"));
-	totalPhaseInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetTotalPhaseData()), _T("Total Phase"));
-
-	individualAmplitudeInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetAmplitudeData(index - 1)), wxEmptyString);
-	individualPhaseInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetPhaseData(index - 1)), wxEmptyString);
-	UpdateCurveProperties(index - 1, GetNextColor(index), true, false);
-	UpdatePlotDisplays();
+	UpdatePlotData();
 }
 
 //==========================================================================
@@ -657,10 +690,12 @@ unsigned int MainFrame::AddDataRowToGrid(const wxString &name)
 	optionsGrid->SetCellRenderer(index, colVisible, new wxGridCellBoolRenderer);
 	optionsGrid->SetCellRenderer(index, colRightAxis, new wxGridCellBoolRenderer);
 	optionsGrid->SetCellEditor(index, colLineSize, new wxGridCellNumberEditor(1, maxLineSize));
+	optionsGrid->SetCellEditor(index, colResolution, new wxGridCellNumberEditor(0, 100000000));
 
 	for (unsigned int i = 0; i < colCount; ++i)
 			optionsGrid->SetReadOnly(index, i, true);
 	optionsGrid->SetReadOnly(index, colLineSize, false);
+	optionsGrid->SetReadOnly(index, colResolution, false);
 	optionsGrid->SetCellValue(index, colName, name);
 
 	LibPlot2D::Color color = GetNextColor(index);
@@ -668,6 +703,7 @@ unsigned int MainFrame::AddDataRowToGrid(const wxString &name)
 	optionsGrid->SetCellBackgroundColour(index, colColor, color.ToWxColor());
 	optionsGrid->SetCellValue(index, colLineSize, _T("1"));
 	optionsGrid->SetCellValue(index, colVisible, _T("1"));
+	optionsGrid->SetCellValue(index, colResolution, _T("0"));// Zero uses the global resolution
 
 /*	int width = optionsGrid->GetColumnWidth(colName);
 	optionsGrid->AutoSizeColumn(colName);
@@ -761,14 +797,15 @@ void MainFrame::RemoveCurve(const unsigned int &i)
 	}
 	else
 	{
-		individualAmplitudeInterface.RemoveCurve(i);
-		individualPhaseInterface.RemoveCurve(i);
-
-		totalAmplitudeInterface.ClearAllCurves();
-		totalPhaseInterface.ClearAllCurves();
-
-		totalAmplitudeInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetTotalAmplitudeData()), _T("Total Amplitude"));
-		totalPhaseInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetTotalPhaseData()), _T("Total Phase"));
+		// Curves that have not been solved yet were never plotted
+		if (i < plottedCurves.size())
+		{
+			individualAmplitudeInterface.RemoveCurve(i);
+			individualPhaseInterface.RemoveCurve(i);
+			plottedCurves.erase(plottedCurves.begin() + i);
+		}
+
+		UpdatePlotData();
 	}
 }
 
@@ -957,11 +994,6 @@ void MainFrame::UpdateCurveProperties(const unsigned int &index, const LibPlot2D
 	optionsGrid->GetCellValue(index + 1, colLineSize).ToULong(&lineSize);
 	individualAmplitudePlot->SetCurveProperties(index, color, visible, rightAxis, lineSize, -1);
 	individualPhasePlot->SetCurveProperties(index, color, visible, rightAxis, lineSize, -1);
-
-	if (totalAmplitudeInterface.GetCurveCount() > 0)
-		totalAmplitudePlot->SetCurveProperties(0, LibPlot2D::Color::ColorBlue, true, false, 1, 0);
-	if (totalPhaseInterface.GetCurveCount() > 0)
-		totalPhasePlot->SetCurveProperties(0, LibPlot2D::Color::ColorBlue, true, false, 1, 0);
 }
 
 //==========================================================================
@@ -983,13 +1015,28 @@ void MainFrame::UpdateCurveProperties(const unsigned int &index, const LibPlot2D
 void MainFrame::GridCellChangeEvent(wxGridEvent &event)
 {
 	unsigned int row(event.GetRow());
-	if (row == 0 || event.GetCol() != colLineSize)
+	if (row == 0 || (event.GetCol() != colLineSize && event.GetCol() != colResolution))
 	{
 		event.Skip();
 		return;
 	}
 
-	UpdateCurveProperties(row - 1);
+	if (event.GetCol() == colLineSize)
+	{
+		UpdateCurveProperties(row - 1);
+		return;
+	}
+
+	unsigned long resolution;
+	if (!optionsGrid->GetCellValue(row, colResolution).ToULong(&resolution) ||
+		!dataManager.SetResolution(row - 1, resolution))
+	{
+		optionsGrid->SetCellValue(row, colResolution,
+			wxString::Format("%u", dataManager.GetResolution(row - 1)));
+		return;
+	}
+
+	UpdatePlotData();
 }
 
 //==========================================================================
@@ -1068,7 +1115,7 @@ void MainFrame::SetXLabels()
 // Function:		TextBoxChangeEvent
 //
 // Description:		Event handler for text box change (really loss of focus)
-//					events.
+//					events.  Nothing is re-solved unless a box was edited.
 //
 // Input Arguments:
 //		event	= wxFocusEvent&
@@ -1083,10 +1130,15 @@ void MainFrame::SetXLabels()
 void MainFrame::TextBoxChangeEvent(wxFocusEvent& event)
 {
 	double min, max;
-	if (minFrequencyTextBox->GetValue().ToDouble(&min) &&
+	if ((minFrequencyTextBox->IsModified() || maxFrequencyTextBox->IsModified()) &&
+		minFrequencyTextBox->GetValue().ToDouble(&min) &&
 		maxFrequencyTextBox->GetValue().ToDouble(&max))
+	{
+		minFrequencyTextBox->DiscardEdits();
+		maxFrequencyTextBox->DiscardEdits();
 		dataManager.SetFrequencyRange(min, max);
-	UpdatePlotData();
+		UpdatePlotData();
+	}
 	event.Skip();// Without skipping the event, the cursot gets stuck in the box and we never loose focus
 }
 
@@ -1094,7 +1146,9 @@ void MainFrame::TextBoxChangeEvent(wxFocusEvent& event)
 // Class:			MainFrame
 // Function:		RadioButtonChangeEvent
 //
-// Description:		Event handler for radio button change events.
+// Description:		Event handler for radio button change events.  The
+//					frequency range is converted to the new units, so the
+//					data does not need to be re-solved.
 //
 // Input Arguments:
 //		event	= wxCommandEvent& (unused)
@@ -1113,14 +1167,240 @@ void MainFrame::RadioButtonChangeEvent(wxCommandEvent& WXUNUSED(event))
 		dataManager.SetFrequencyUnitsHertz();
 	else
 		dataManager.SetFrequencyUnitsRadPerSec();
+
+	minFrequencyTextBox->ChangeValue(wxString::Format("%g", dataManager.GetMinFrequency()));
+	maxFrequencyTextBox->ChangeValue(wxString::Format("%g", dataManager.GetMaxFrequency()));
+	UpdatePlotData();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ThreadCountChangeEvent
+//
+// Description:		Event handler for changes to the number of threads.
+//
+// Input Arguments:
+//		event	= wxSpinEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ThreadCountChangeEvent(wxSpinEvent& WXUNUSED(event))
+{
+	dataManager.SetThreadCount(threadCountSpinCtrl->GetValue());
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ResolutionChangeEvent
+//
+// Description:		Event handler for changes to the global number of points.
+//					Values that would use too much memory are reverted.
+//
+// Input Arguments:
+//		event	= wxSpinEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ResolutionChangeEvent(wxSpinEvent& WXUNUSED(event))
+{
+	if (!dataManager.SetResolution(resolutionSpinCtrl->GetValue()))
+	{
+		resolutionSpinCtrl->SetValue(dataManager.GetResolution());
+		return;
+	}
+
+	UpdatePlotData();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		AdaptiveSamplingChangeEvent
+//
+// Description:		Event handler for turning adaptive sampling on or off.
+//
+// Input Arguments:
+//		event	= wxCommandEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::AdaptiveSamplingChangeEvent(wxCommandEvent& WXUNUSED(event))
+{
+	if (!dataManager.SetAdaptiveSampling(adaptiveSamplingCheckBox->GetValue()))
+	{
+		adaptiveSamplingCheckBox->SetValue(dataManager.GetAdaptiveSampling());
+		return;
+	}
+
+	UpdatePlotData();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		SolveCompleteEvent
+//
+// Description:		Event handler for results from the background solver.
+//					Results made stale by later changes are discarded.
+//
+// Input Arguments:
+//		event	= wxThreadEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::SolveCompleteEvent(wxThreadEvent& WXUNUSED(event))
+{
+	if (dataManager.ApplySolveResults())
+		UpdatePlotData();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		PlotPaintEvent
+//
+// Description:		Event handler for repainting any of the plots.  The plot
+//					paints itself; its view is checked once it has finished,
+//					since the view may be updated while painting.
+//
+// Input Arguments:
+//		event	= wxPaintEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::PlotPaintEvent(wxPaintEvent &event)
+{
+	event.Skip();
+	CallAfter(&MainFrame::CheckPlotViews);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		CheckPlotViews
+//
+// Description:		Checks the plots for changes to their X ranges or widths.
+//					While they keep changing, the view timer is restarted, so
+//					the visible range is only solved again and curves are
+//					only decimated again once the views are steady.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::CheckPlotViews()
+{
+	const std::vector<PlotView> views(GetPlotViews());
+	bool changed(false);
+	for (unsigned int i = 0; i < plotCount; ++i)
+	{
+		if (views[i] == plotViews[i])
+			continue;
+
+		if (views[i].xMin != plotViews[i].xMin || views[i].xMax != plotViews[i].xMax)
+			zoomedPlot = i;
+		changed = true;
+	}
+
+	if (!changed)
+		return;
+
+	plotViews = views;
+	viewTimer.Start(200, wxTIMER_ONE_SHOT);// [msec]
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ViewTimerEvent
+//
+// Description:		Event handler for the views becoming steady.  The range
+//					of the plot most recently zoomed is passed to the data
+//					manager, which solves it again if it holds too few
+//					points, and curves are decimated again for the new views.
+//
+// Input Arguments:
+//		event	= wxTimerEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ViewTimerEvent(wxTimerEvent& WXUNUSED(event))
+{
+	dataManager.SetVisibleRange(plotViews[zoomedPlot].xMin, plotViews[zoomedPlot].xMax);
 	UpdatePlotData();
 }
 
+//==========================================================================
+// Class:			MainFrame
+// Function:		GetPlotViews
+//
+// Description:		Returns the current X range and width of each plot.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<PlotView>, in the order of Plots
+//
+//==========================================================================
+std::vector<MainFrame::PlotView> MainFrame::GetPlotViews() const
+{
+	LibPlot2D::PlotRenderer *plots[] = { individualAmplitudePlot, individualPhasePlot,
+		totalAmplitudePlot, totalPhasePlot };
+
+	std::vector<PlotView> views(plotCount);
+	for (unsigned int i = 0; i < plotCount; ++i)
+	{
+		views[i].xMin = plots[i]->GetXMin();
+		views[i].xMax = plots[i]->GetXMax();
+		views[i].width = plots[i]->GetClientSize().GetWidth();
+	}
+
+	return views;
+}
+
 //==========================================================================
 // Class:			MainFrame
 // Function:		UpdatePlotData
 //
-// Description:		Updates data for all rendered plots.
+// Description:		Updates data for all rendered plots.  Curves are
+//					decimated to the width of their plot, and are only copied
+//					into the plots when their data changed or when the points
+//					kept for the current view differ from those plotted.
 //
 // Input Arguments:
 //		None
@@ -1134,26 +1414,139 @@ void MainFrame::RadioButtonChangeEvent(wxCommandEvent& WXUNUSED(event))
 //==========================================================================
 void MainFrame::UpdatePlotData()
 {
-	dataManager.UpdateTotalTransferFunctionData();
+	// A new grid or new units changes the X data of every curve
+	const bool hertz(dataManager.GetFrequencyUnitsHertz());
+	if (dataManager.GetFrequencyGrid() != plottedGrid || hertz != plottedHertz)
+	{
+		individualAmplitudeInterface.ClearAllCurves();
+		individualPhaseInterface.ClearAllCurves();
+		totalAmplitudeInterface.ClearAllCurves();
+		totalPhaseInterface.ClearAllCurves();
 
-	individualAmplitudeInterface.ClearAllCurves();
-	individualPhaseInterface.ClearAllCurves();
-	totalAmplitudeInterface.ClearAllCurves();
-	totalPhaseInterface.ClearAllCurves();
+		plottedCurves.clear();
+		plottedTotal = PlottedCurve();
+		plottedGrid = dataManager.GetFrequencyGrid();
+		plottedHertz = hertz;
+	}
+
+	const std::vector<PlotView> views(GetPlotViews());
+	std::vector<CurveDecimator> decimators;
+	for (const auto& view : views)
+		decimators.emplace_back(view.xMin, view.xMax, static_cast<unsigned int>(std::max(view.width, 0)));
+
+	// Curves stop at the first one not yet solved.  Curves are only
+	// decimated again when their data or their plot's view changed.
+	unsigned int count(0);
+	while (count < dataManager.GetCount() && dataManager.GetResponse(count))
+		++count;
+
+	const unsigned int plottedCount(static_cast<unsigned int>(plottedCurves.size()));
+	plottedCurves.resize(count);
+	unsigned int first(count);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		PlottedCurve& curve(plottedCurves[i]);
+		const bool dataChanged(i >= plottedCount || curve.response != dataManager.GetResponse(i) ||
+			curve.zoomResponse != dataManager.GetZoomResponse(i));
+		curve.response = dataManager.GetResponse(i);
+		curve.zoomResponse = dataManager.GetZoomResponse(i);
+
+		const bool amplitudeChanged(UpdateKeptPoints(dataManager.GetAmplitudeCurve(i),
+			decimators[plotIndividualAmplitude], views[plotIndividualAmplitude], dataChanged, curve.amplitude));
+		const bool phaseChanged(UpdateKeptPoints(dataManager.GetPhaseCurve(i),
+			decimators[plotIndividualPhase], views[plotIndividualPhase], dataChanged, curve.phase));
+		if (first == count && (amplitudeChanged || phaseChanged))
+			first = i;
+	}
 
-	for (unsigned int i = 0; i < dataManager.GetCount(); ++i)
+	// Curves can only be appended to the plots, so every curve after the
+	// first changed curve is removed and added again, with its properties.
+	// This is only a copy of its decimated points.
+	for (unsigned int i = plottedCount; i > first; --i)
 	{
-		individualAmplitudeInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetAmplitudeData(i)), wxEmptyString);
-		individualPhaseInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetPhaseData(i)), wxEmptyString);
+		individualAmplitudeInterface.RemoveCurve(i - 1);
+		individualPhaseInterface.RemoveCurve(i - 1);
+	}
+
+	for (unsigned int i = first; i < count; ++i)
+	{
+		individualAmplitudeInterface.AddCurve(CurveDecimator::Extract(
+			dataManager.GetAmplitudeCurve(i), plottedCurves[i].amplitude.points), wxEmptyString);
+		individualPhaseInterface.AddCurve(CurveDecimator::Extract(
+			dataManager.GetPhaseCurve(i), plottedCurves[i].phase.points), wxEmptyString);
 		UpdateCurveProperties(i);
 	}
 
-	totalAmplitudeInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetTotalAmplitudeData()), _T("Total Amplitude"));
-	totalPhaseInterface.AddCurve(std::make_unique<LibPlot2D::Dataset2D>(dataManager.GetTotalPhaseData()), _T("Total Phase"));
+	const bool totalDataChanged(plottedTotal.response != dataManager.GetTotalResponse() ||
+		plottedTotal.zoomResponse != dataManager.GetZoomTotalResponse());
+	plottedTotal.response = dataManager.GetTotalResponse();
+	plottedTotal.zoomResponse = dataManager.GetZoomTotalResponse();
+
+	bool totalChanged(totalDataChanged);
+	if (plottedTotal.response)
+	{
+		const bool amplitudeChanged(UpdateKeptPoints(dataManager.GetTotalAmplitudeCurve(),
+			decimators[plotTotalAmplitude], views[plotTotalAmplitude], totalDataChanged, plottedTotal.amplitude));
+		const bool phaseChanged(UpdateKeptPoints(dataManager.GetTotalPhaseCurve(),
+			decimators[plotTotalPhase], views[plotTotalPhase], totalDataChanged, plottedTotal.phase));
+		totalChanged = amplitudeChanged || phaseChanged;
+	}
+
+	if (totalChanged)
+	{
+		totalAmplitudeInterface.ClearAllCurves();
+		totalPhaseInterface.ClearAllCurves();
+
+		if (plottedTotal.response)
+		{
+			totalAmplitudeInterface.AddCurve(CurveDecimator::Extract(
+				dataManager.GetTotalAmplitudeCurve(), plottedTotal.amplitude.points), _T("Total Amplitude"));
+			totalPhaseInterface.AddCurve(CurveDecimator::Extract(
+				dataManager.GetTotalPhaseCurve(), plottedTotal.phase.points), _T("Total Phase"));
+			totalAmplitudePlot->SetCurveProperties(0, LibPlot2D::Color::ColorBlue, true, false, 1, 0);
+			totalPhasePlot->SetCurveProperties(0, LibPlot2D::Color::ColorBlue, true, false, 1, 0);
+		}
+	}
 
 	UpdatePlotDisplays();
 }
 
+//==========================================================================
+// Class:			MainFrame
+// Function:		UpdateKeptPoints
+//
+// Description:		Decimates a curve for its plot's view, unless neither
+//					the curve's data nor the view changed since it was last
+//					decimated.
+//
+// Input Arguments:
+//		curve		= const CurveDecimator::Curve&
+//		decimator	= const CurveDecimator&, for the view
+//		view		= const PlotView&
+//		dataChanged	= const bool&
+//
+// Output Arguments:
+//		kept		= KeptPoints&
+//
+// Return Value:
+//		bool, true if the curve must be copied into the plot again
+//
+//==========================================================================
+bool MainFrame::UpdateKeptPoints(const CurveDecimator::Curve &curve, const CurveDecimator &decimator,
+	const PlotView &view, const bool &dataChanged, KeptPoints &kept)
+{
+	if (!dataChanged && view == kept.view)
+		return false;
+
+	std::vector<unsigned int> points(decimator.GetKeptPoints(curve));
+	kept.view = view;
+	if (!dataChanged && points == kept.points)
+		return false;
+
+	kept.points.swap(points);
+	return true;
+}
+
 //==========================================================================
 // Class:			MainFrame
 // Function:		UpdatePlotDisplays
@@ -27,6 +27,7 @@
 // Standard C++ headers
 #include <fstream>
 #include <vector>
+#include <memory>
 
 // LibPlot2D forward delcarations
 namespace LibPlot2D
@@ -40,6 +41,8 @@ class wxGrid;
 class wxGridEvent;
 class wxSplitterWindow;
 class wxSplitterEvent;
+class wxSpinCtrl;
+class wxSpinEvent;
 
 class MainFrame : public wxFrame
 {
@@ -65,6 +68,10 @@ private:
 	wxTextCtrl *minFrequencyTextBox;
 	wxTextCtrl *maxFrequencyTextBox;
 
+	wxSpinCtrl *threadCountSpinCtrl;
+	wxSpinCtrl *resolutionSpinCtrl;
+	wxCheckBox *adaptiveSamplingCheckBox;
+
 	LibPlot2D::PlotRenderer *individualAmplitudePlot;
 	LibPlot2D::PlotRenderer *individualPhasePlot;
 	LibPlot2D::PlotRenderer *totalAmplitudePlot;
@@ -85,6 +92,7 @@ private:
 		colDifference,
 		colVisible,
 		colRightAxis,
+		colResolution,
 
 		colCount
 	};
@@ -114,12 +122,75 @@ private:
 
 	DataManager dataManager;
 
+	// Curves are decimated for the X range and width of their plot
+	struct PlotView
+	{
+		double xMin;
+		double xMax;
+		int width;// [pixels]
+
+		bool operator==(const PlotView &view) const { return xMin == view.xMin && xMax == view.xMax && width == view.width; }
+		bool operator!=(const PlotView &view) const { return !(*this == view); }
+	};
+
+	enum Plots
+	{
+		plotIndividualAmplitude = 0,
+		plotIndividualPhase,
+		plotTotalAmplitude,
+		plotTotalPhase,
+
+		plotCount
+	};
+
+	// The data currently copied into the plots, for finding what changed.
+	// Only the indices of the points kept by decimation are stored; the
+	// points themselves are read from the responses.
+	struct KeptPoints
+	{
+		PlotView view;// Decimated for
+		std::vector<unsigned int> points;// Empty for all
+	};
+
+	struct PlottedCurve
+	{
+		std::shared_ptr<const DataManager::Response> response;
+		std::shared_ptr<const DataManager::Response> zoomResponse;
+		KeptPoints amplitude;
+		KeptPoints phase;
+	};
+
+	std::vector<PlottedCurve> plottedCurves;
+	PlottedCurve plottedTotal;
+	std::shared_ptr<const FrequencyGrid> plottedGrid;
+	bool plottedHertz;
+
+	static bool UpdateKeptPoints(const CurveDecimator::Curve &curve, const CurveDecimator &decimator,
+		const PlotView &view, const bool &dataChanged, KeptPoints &kept);
+
+	std::vector<PlotView> GetPlotViews() const;// In the order of Plots
+
+	// The plots do not report zooming or resizing, but they are repainted
+	// whenever their views change, so the views are checked after each
+	// repaint.  The timer only runs until the views stop changing.
+	wxTimer viewTimer;// One shot
+	std::vector<PlotView> plotViews;// Last seen for each plot
+	unsigned int zoomedPlot;// Most recent to change range
+	void CheckPlotViews();
+
 	// The event IDs
 	enum MainFrameEventID
 	{
 		idAddButton = wxID_HIGHEST + 100,
 		idRemoveButton,
 		idRemoveAllButton,
+
+		idThreadCount,
+		idResolution,
+		idAdaptiveSampling,
+
+		idViewTimer,
+		idSolveComplete
 	};
 
 	// Event handlers-----------------------------------------------------
@@ -131,6 +202,16 @@ private:
 	// Other input controls
 	void TextBoxChangeEvent(wxFocusEvent &event);
 	void RadioButtonChangeEvent(wxCommandEvent &event);
+	void ThreadCountChangeEvent(wxSpinEvent &event);
+	void ResolutionChangeEvent(wxSpinEvent &event);
+	void AdaptiveSamplingChangeEvent(wxCommandEvent &event);
+
+	// Posted by the background solver
+	void SolveCompleteEvent(wxThreadEvent &event);
+
+	// Plots
+	void PlotPaintEvent(wxPaintEvent &event);
+	void ViewTimerEvent(wxTimerEvent &event);
 
 	// Grid events
 	void GridRightClickEvent(wxGridEvent &event);
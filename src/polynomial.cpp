@@ -0,0 +1,293 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  polynomial.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Polynomial in s with real coefficients.
+
+// Local headers
+#include "polynomial.h"
+
+// Standard C++ headers
+#include <algorithm>
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		Polynomial
+//
+// Description:		Constructor for Polynomial class.  Creates a constant.
+//
+// Input Arguments:
+//		constant	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+Polynomial::Polynomial(const double &constant) : coefficients(1, constant)
+{
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		Polynomial
+//
+// Description:		Constructor for Polynomial class.
+//
+// Input Arguments:
+//		coefficients	= std::vector<double>, in order of increasing power
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+Polynomial::Polynomial(std::vector<double> coefficients) : coefficients(std::move(coefficients))
+{
+	RemoveLeadingZeros();
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		S
+//
+// Description:		Returns the polynomial "s".
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Polynomial
+//
+//==========================================================================
+Polynomial Polynomial::S()
+{
+	return Polynomial(std::vector<double>({ 0.0, 1.0 }));
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		GetOrder
+//
+// Description:		Returns the order of the polynomial.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int Polynomial::GetOrder() const
+{
+	if (coefficients.empty())
+		return 0;
+	return coefficients.size() - 1;
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		EvaluateImaginary
+//
+// Description:		Evaluates the polynomial at s = j * omega using Horner's
+//					method.  Since the coefficients are real and s is purely
+//					imaginary, each step is only two multiplications.
+//
+// Input Arguments:
+//		omega	= const double& [rad/sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		LibPlot2D::Complex
+//
+//==========================================================================
+LibPlot2D::Complex Polynomial::EvaluateImaginary(const double &omega) const
+{
+	double real(0.0), imaginary(0.0);
+	for (auto c = coefficients.rbegin(); c != coefficients.rend(); ++c)
+	{
+		const double temp(-imaginary * omega + *c);
+		imaginary = real * omega;
+		real = temp;
+	}
+
+	return LibPlot2D::Complex(real, imaginary);
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		ToPower
+//
+// Description:		Raises the polynomial to the specified power.
+//
+// Input Arguments:
+//		power	= unsigned int
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Polynomial
+//
+//==========================================================================
+Polynomial Polynomial::ToPower(unsigned int power) const
+{
+	Polynomial result(1.0), base(*this);
+	while (power > 0)
+	{
+		if (power & 1)
+			result = result * base;
+		power >>= 1;
+		if (power > 0)
+			base = base * base;
+	}
+
+	return result;
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		operator+
+//
+// Description:		Addition operator for Polynomial class.
+//
+// Input Arguments:
+//		p	= const Polynomial&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Polynomial
+//
+//==========================================================================
+Polynomial Polynomial::operator+(const Polynomial &p) const
+{
+	std::vector<double> result(std::max(coefficients.size(), p.coefficients.size()), 0.0);
+	for (unsigned int i = 0; i < coefficients.size(); ++i)
+		result[i] += coefficients[i];
+	for (unsigned int i = 0; i < p.coefficients.size(); ++i)
+		result[i] += p.coefficients[i];
+
+	return Polynomial(std::move(result));
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		operator-
+//
+// Description:		Subtraction operator for Polynomial class.
+//
+// Input Arguments:
+//		p	= const Polynomial&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Polynomial
+//
+//==========================================================================
+Polynomial Polynomial::operator-(const Polynomial &p) const
+{
+	return *this + p * -1.0;
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		operator*
+//
+// Description:		Multiplication operator for Polynomial class.
+//
+// Input Arguments:
+//		p	= const Polynomial&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Polynomial
+//
+//==========================================================================
+Polynomial Polynomial::operator*(const Polynomial &p) const
+{
+	if (coefficients.empty() || p.coefficients.empty())
+		return Polynomial();
+
+	std::vector<double> result(coefficients.size() + p.coefficients.size() - 1, 0.0);
+	for (unsigned int i = 0; i < coefficients.size(); ++i)
+	{
+		for (unsigned int j = 0; j < p.coefficients.size(); ++j)
+			result[i + j] += coefficients[i] * p.coefficients[j];
+	}
+
+	return Polynomial(std::move(result));
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		operator*
+//
+// Description:		Multiplication operator for Polynomial class.
+//
+// Input Arguments:
+//		d	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Polynomial
+//
+//==========================================================================
+Polynomial Polynomial::operator*(const double &d) const
+{
+	std::vector<double> result(coefficients);
+	for (auto& c : result)
+		c *= d;
+
+	return Polynomial(std::move(result));
+}
+
+//==========================================================================
+// Class:			Polynomial
+// Function:		RemoveLeadingZeros
+//
+// Description:		Removes zero coefficients of the highest powers, so the
+//					order is reported correctly.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Polynomial::RemoveLeadingZeros()
+{
+	while (coefficients.size() > 1 && coefficients.back() == 0.0)
+		coefficients.pop_back();
+}
@@ -0,0 +1,57 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  polynomial.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Polynomial in s with real coefficients.
+
+#ifndef _POLYNOMIAL_H_
+#define _POLYNOMIAL_H_
+
+// LibPlot2D headers
+#include <lp2d/utilities/math/complex.h>
+
+// Standard C++ headers
+#include <vector>
+
+class Polynomial
+{
+public:
+	Polynomial() = default;
+	explicit Polynomial(const double &constant);
+	explicit Polynomial(std::vector<double> coefficients);
+
+	static Polynomial S();
+
+	// Coefficients are stored in order of increasing power
+	const std::vector<double>& GetCoefficients() const { return coefficients; }
+	unsigned int GetOrder() const;
+	bool IsConstant() const { return GetOrder() == 0; }
+
+	// Evaluates at s = j * omega using Horner's method
+	LibPlot2D::Complex EvaluateImaginary(const double &omega) const;
+
+	Polynomial ToPower(unsigned int power) const;
+
+	Polynomial operator+(const Polynomial &p) const;
+	Polynomial operator-(const Polynomial &p) const;
+	Polynomial operator*(const Polynomial &p) const;
+	Polynomial operator*(const double &d) const;
+
+	bool operator==(const Polynomial &p) const { return coefficients == p.coefficients; }
+	bool operator!=(const Polynomial &p) const { return !(*this == p); }
+
+private:
+	std::vector<double> coefficients;
+
+	void RemoveLeadingZeros();
+};
+
+#endif// _POLYNOMIAL_H_
@@ -0,0 +1,372 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  rationalFunction.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Ratio of two polynomials in s.  Used to evaluate transfer functions
+//				 with one Horner pass per polynomial at each frequency.  The factors
+//				 that make up the numerator and denominator are also retained, so
+//				 roots can be found without expanding products.
+
+// Local headers
+#include "rationalFunction.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		RationalFunction
+//
+// Description:		Constructor for RationalFunction class.  Creates a constant.
+//
+// Input Arguments:
+//		constant	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+RationalFunction::RationalFunction(const double &constant)
+	: numerator(constant), denominator(1.0), numeratorFactors(1, { numerator, 1 })
+{
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		RationalFunction
+//
+// Description:		Constructor for RationalFunction class.
+//
+// Input Arguments:
+//		numerator	= Polynomial
+//		denominator	= Polynomial
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+RationalFunction::RationalFunction(Polynomial numerator, Polynomial denominator)
+	: numerator(std::move(numerator)), denominator(std::move(denominator))
+{
+	numeratorFactors.push_back({ this->numerator, 1 });
+	denominatorFactors.push_back({ this->denominator, 1 });
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		GetOrder
+//
+// Description:		Returns the larger of the numerator and denominator orders.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int RationalFunction::GetOrder() const
+{
+	return std::max(numerator.GetOrder(), denominator.GetOrder());
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		Evaluate
+//
+// Description:		Evaluates the function at s = j * omega for each
+//					specified angular frequency.
+//
+// Input Arguments:
+//		omega	= const std::vector<double>& [rad/sec]
+//
+// Output Arguments:
+//		response	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RationalFunction::Evaluate(const std::vector<double> &omega,
+	ComplexVector &response) const
+{
+	response.Resize(omega.size());
+	Evaluate(omega, 0, omega.size(), response);
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		Evaluate
+//
+// Description:		Evaluates the function at s = j * omega for the specified
+//					range of angular frequencies.  Results are written to the
+//					same positions in the response, which must already be
+//					large enough.
+//
+// Input Arguments:
+//		omega	= const std::vector<double>& [rad/sec]
+//		start	= const unsigned int&, first index to evaluate
+//		end		= const unsigned int&, one past the last index to evaluate
+//
+// Output Arguments:
+//		response	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RationalFunction::Evaluate(const std::vector<double> &omega, const unsigned int &start,
+	const unsigned int &end, ComplexVector &response) const
+{
+	for (unsigned int i = start; i < end; ++i)
+		response.SetValue(i, numerator.EvaluateImaginary(omega[i]) / denominator.EvaluateImaginary(omega[i]));
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		ToPower
+//
+// Description:		Raises the function to the specified integer power.  The
+//					factors are kept, with their powers multiplied; constant
+//					factors are raised directly, so their powers cannot
+//					overflow however many times they are raised.
+//
+// Input Arguments:
+//		power	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		RationalFunction
+//
+//==========================================================================
+RationalFunction RationalFunction::ToPower(const int &power) const
+{
+	RationalFunction result;
+	if (power < 0)
+	{
+		result.numerator = denominator.ToPower(-power);
+		result.denominator = numerator.ToPower(-power);
+	}
+	else
+	{
+		result.numerator = numerator.ToPower(power);
+		result.denominator = denominator.ToPower(power);
+	}
+
+	if (power == 0)
+		return result;
+
+	const unsigned int magnitude(static_cast<unsigned int>(abs(power)));
+	result.numeratorFactors = power < 0 ? denominatorFactors : numeratorFactors;
+	result.denominatorFactors = power < 0 ? numeratorFactors : denominatorFactors;
+	RaiseFactors(result.numeratorFactors, magnitude);
+	RaiseFactors(result.denominatorFactors, magnitude);
+
+	return result;
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		RaiseFactors
+//
+// Description:		Raises each of the specified factors to the specified
+//					power.
+//
+// Input Arguments:
+//		power	= const unsigned int&
+//
+// Output Arguments:
+//		factors	= std::vector<Factor>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RationalFunction::RaiseFactors(std::vector<Factor> &factors, const unsigned int &power)
+{
+	for (auto& factor : factors)
+	{
+		if (factor.polynomial.IsConstant())
+			factor.polynomial = factor.polynomial.ToPower(factor.power * power);
+		else
+			factor.power *= power;
+	}
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		operator+
+//
+// Description:		Addition operator for RationalFunction class.
+//
+// Input Arguments:
+//		r	= const RationalFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		RationalFunction
+//
+//==========================================================================
+RationalFunction RationalFunction::operator+(const RationalFunction &r) const
+{
+	RationalFunction result;
+	if (denominator == r.denominator)
+	{
+		result.numerator = numerator + r.numerator;
+		result.denominator = denominator;
+		result.denominatorFactors = denominatorFactors;
+	}
+	else
+	{
+		result.numerator = numerator * r.denominator + r.numerator * denominator;
+		result.denominator = denominator * r.denominator;
+		result.denominatorFactors = Concatenate(denominatorFactors, r.denominatorFactors);
+	}
+
+	result.numeratorFactors.push_back({ result.numerator, 1 });
+	return result;
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		operator-
+//
+// Description:		Subtraction operator for RationalFunction class.
+//
+// Input Arguments:
+//		r	= const RationalFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		RationalFunction
+//
+//==========================================================================
+RationalFunction RationalFunction::operator-(const RationalFunction &r) const
+{
+	return *this + -r;
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		operator*
+//
+// Description:		Multiplication operator for RationalFunction class.
+//
+// Input Arguments:
+//		r	= const RationalFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		RationalFunction
+//
+//==========================================================================
+RationalFunction RationalFunction::operator*(const RationalFunction &r) const
+{
+	RationalFunction result;
+	result.numerator = numerator * r.numerator;
+	result.denominator = denominator * r.denominator;
+	result.numeratorFactors = Concatenate(numeratorFactors, r.numeratorFactors);
+	result.denominatorFactors = Concatenate(denominatorFactors, r.denominatorFactors);
+	return result;
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		operator/
+//
+// Description:		Division operator for RationalFunction class.
+//
+// Input Arguments:
+//		r	= const RationalFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		RationalFunction
+//
+//==========================================================================
+RationalFunction RationalFunction::operator/(const RationalFunction &r) const
+{
+	RationalFunction result;
+	result.numerator = numerator * r.denominator;
+	result.denominator = denominator * r.numerator;
+	result.numeratorFactors = Concatenate(numeratorFactors, r.denominatorFactors);
+	result.denominatorFactors = Concatenate(denominatorFactors, r.numeratorFactors);
+	return result;
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		operator-
+//
+// Description:		Negation operator for RationalFunction class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		RationalFunction
+//
+//==========================================================================
+RationalFunction RationalFunction::operator-() const
+{
+	RationalFunction result(*this);
+	result.numerator = numerator * -1.0;
+	result.numeratorFactors.push_back({ Polynomial(-1.0), 1 });
+	return result;
+}
+
+//==========================================================================
+// Class:			RationalFunction
+// Function:		Concatenate
+//
+// Description:		Returns a list containing the factors from both arguments.
+//
+// Input Arguments:
+//		a	= const std::vector<Factor>&
+//		b	= const std::vector<Factor>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<Factor>
+//
+//==========================================================================
+std::vector<RationalFunction::Factor> RationalFunction::Concatenate(const std::vector<Factor> &a,
+	const std::vector<Factor> &b)
+{
+	std::vector<Factor> result(a);
+	result.insert(result.end(), b.begin(), b.end());
+	return result;
+}
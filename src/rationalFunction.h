@@ -0,0 +1,76 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  rationalFunction.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Ratio of two polynomials in s.  Used to evaluate transfer functions
+//				 with one Horner pass per polynomial at each frequency.  The factors
+//				 that make up the numerator and denominator are also retained, so
+//				 roots can be found without expanding products.
+
+#ifndef _RATIONAL_FUNCTION_H_
+#define _RATIONAL_FUNCTION_H_
+
+// Local headers
+#include "polynomial.h"
+#include "complexVector.h"
+
+// Standard C++ headers
+#include <vector>
+
+class RationalFunction
+{
+public:
+	RationalFunction() = default;
+	explicit RationalFunction(const double &constant);
+	RationalFunction(Polynomial numerator, Polynomial denominator);
+
+	const Polynomial& GetNumerator() const { return numerator; }
+	const Polynomial& GetDenominator() const { return denominator; }
+
+	// Products of these (each raised to its power) are equal to the numerator
+	// and denominator.  Powers are stored instead of repeated factors, so the
+	// lists do not grow with the exponent.
+	struct Factor
+	{
+		Polynomial polynomial;
+		unsigned int power;
+	};
+
+	const std::vector<Factor>& GetNumeratorFactors() const { return numeratorFactors; }
+	const std::vector<Factor>& GetDenominatorFactors() const { return denominatorFactors; }
+	unsigned int GetOrder() const;
+
+	// Angular frequencies are in [rad/sec]
+	void Evaluate(const std::vector<double> &omega, ComplexVector &response) const;
+	void Evaluate(const std::vector<double> &omega, const unsigned int &start,
+		const unsigned int &end, ComplexVector &response) const;
+
+	RationalFunction ToPower(const int &power) const;
+
+	RationalFunction operator+(const RationalFunction &r) const;
+	RationalFunction operator-(const RationalFunction &r) const;
+	RationalFunction operator*(const RationalFunction &r) const;
+	RationalFunction operator/(const RationalFunction &r) const;
+	RationalFunction operator-() const;
+
+private:
+	Polynomial numerator;
+	Polynomial denominator;
+
+	std::vector<Factor> numeratorFactors;
+	std::vector<Factor> denominatorFactors;
+
+	static void RaiseFactors(std::vector<Factor> &factors, const unsigned int &power);
+	static std::vector<Factor> Concatenate(const std::vector<Factor> &a,
+		const std::vector<Factor> &b);
+};
+
+#endif// _RATIONAL_FUNCTION_H_
@@ -0,0 +1,367 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  responseProductTree.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Balanced binary tree of partial products of frequency responses.  The
+//				 responses are held as magnitude [dB] and phase [deg], so products are
+//				 computed as sums.  Changing one response only requires updating the
+//				 nodes between its leaf and the root.
+
+// Local headers
+#include "responseProductTree.h"
+
+// Standard C++ headers
+#include <cassert>
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		empty
+//
+// Description:		Data for unused leaves.  Empty data is the identity for
+//					the product.
+//
+//==========================================================================
+const std::vector<double> ResponseProductTree::empty;
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		ResponseProductTree
+//
+// Description:		Constructor for ResponseProductTree class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ResponseProductTree::ResponseProductTree()
+{
+	Clear();
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Insert
+//
+// Description:		Adds a leaf referring to the specified data and updates
+//					the product.  Slots freed by Remove() are reused before
+//					the tree is grown.
+//
+// Input Arguments:
+//		magnitude	= const std::vector<double>& [dB]
+//		phase		= const std::vector<double>& [deg]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, slot of the new leaf
+//
+//==========================================================================
+unsigned int ResponseProductTree::Insert(const std::vector<double> &magnitude,
+	const std::vector<double> &phase)
+{
+	const unsigned int slot(Insert());
+	Set(slot, magnitude, phase);
+	Update(slot);
+
+	return slot;
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Insert
+//
+// Description:		Adds an empty leaf.  Empty leaves do not contribute to
+//					the product, so nothing needs to be updated.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, slot of the new leaf
+//
+//==========================================================================
+unsigned int ResponseProductTree::Insert()
+{
+	if (freeSlots.empty())
+		Grow();
+
+	const unsigned int slot(freeSlots.back());
+	freeSlots.pop_back();
+
+	return slot;
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Remove
+//
+// Description:		Removes the specified leaf and updates the product.
+//
+// Input Arguments:
+//		slot	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Remove(const unsigned int &slot)
+{
+	assert(slot < leafCount);
+
+	leaves[slot] = Leaf();
+	freeSlots.push_back(slot);
+	Update(slot);
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Clear
+//
+// Description:		Removes all leaves.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Clear()
+{
+	leafCount = 2;
+	leaves.assign(leafCount, Leaf());
+	nodes.assign(leafCount, Node());
+	freeSlots = { 1, 0 };
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Set
+//
+// Description:		Refers the specified leaf to new data.  The product is
+//					not updated.
+//
+// Input Arguments:
+//		slot		= const unsigned int&
+//		magnitude	= const std::vector<double>& [dB]
+//		phase		= const std::vector<double>& [deg]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Set(const unsigned int &slot, const std::vector<double> &magnitude,
+	const std::vector<double> &phase)
+{
+	leaves[slot].magnitude = &magnitude;
+	leaves[slot].phase = &phase;
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Update
+//
+// Description:		Recomputes the nodes between the specified leaf and the
+//					root.
+//
+// Input Arguments:
+//		slot	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Update(const unsigned int &slot)
+{
+	for (unsigned int i = (slot + leafCount) / 2; i > 0; i /= 2)
+		UpdateNode(i);
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Rebuild
+//
+// Description:		Recomputes every node.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Rebuild()
+{
+	for (unsigned int i = leafCount - 1; i > 0; --i)
+		UpdateNode(i);
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Grow
+//
+// Description:		Doubles the number of leaves.  Existing leaves keep their
+//					slots, so the whole tree is recomputed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Grow()
+{
+	const unsigned int oldLeafCount(leafCount);
+	leafCount *= 2;
+	leaves.resize(leafCount);
+	nodes.resize(leafCount);
+
+	for (unsigned int slot = leafCount - 1; slot >= oldLeafCount; --slot)
+		freeSlots.push_back(slot);
+
+	Rebuild();
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		UpdateNode
+//
+// Description:		Recomputes the specified node from its children.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::UpdateNode(const unsigned int &i)
+{
+	Combine(GetChildMagnitude(2 * i), GetChildMagnitude(2 * i + 1), nodes[i].magnitude);
+	Combine(GetChildPhase(2 * i), GetChildPhase(2 * i + 1), nodes[i].phase);
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		GetChildMagnitude
+//
+// Description:		Returns the magnitude of the specified node or leaf.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const std::vector<double>& [dB]
+//
+//==========================================================================
+const std::vector<double>& ResponseProductTree::GetChildMagnitude(const unsigned int &i) const
+{
+	if (i < leafCount)
+		return nodes[i].magnitude;
+	else if (leaves[i - leafCount].magnitude)
+		return *leaves[i - leafCount].magnitude;
+	return empty;
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		GetChildPhase
+//
+// Description:		Returns the phase of the specified node or leaf.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const std::vector<double>& [deg]
+//
+//==========================================================================
+const std::vector<double>& ResponseProductTree::GetChildPhase(const unsigned int &i) const
+{
+	if (i < leafCount)
+		return nodes[i].phase;
+	else if (leaves[i - leafCount].phase)
+		return *leaves[i - leafCount].phase;
+	return empty;
+}
+
+//==========================================================================
+// Class:			ResponseProductTree
+// Function:		Combine
+//
+// Description:		Computes the product of two responses, which is the sum
+//					of their magnitudes in dB or of their phases.  Empty data
+//					is treated as the identity.
+//
+// Input Arguments:
+//		a	= const std::vector<double>&
+//		b	= const std::vector<double>&
+//
+// Output Arguments:
+//		result	= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ResponseProductTree::Combine(const std::vector<double> &a, const std::vector<double> &b,
+	std::vector<double> &result)
+{
+	if (a.empty())
+		result = b;
+	else if (b.empty())
+		result = a;
+	else
+	{
+		assert(a.size() == b.size());
+		result.resize(a.size());
+		for (unsigned int i = 0; i < result.size(); ++i)
+			result[i] = a[i] + b[i];
+	}
+}
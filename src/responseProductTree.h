@@ -0,0 +1,83 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  responseProductTree.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Balanced binary tree of partial products of frequency responses.  The
+//				 responses are held as magnitude [dB] and phase [deg], so products are
+//				 computed as sums.  Changing one response only requires updating the
+//				 nodes between its leaf and the root.
+
+#ifndef _RESPONSE_PRODUCT_TREE_H_
+#define _RESPONSE_PRODUCT_TREE_H_
+
+// Standard C++ headers
+#include <vector>
+
+class ResponseProductTree
+{
+public:
+	ResponseProductTree();
+
+	// The leaves refer to the specified data, which must remain valid until the
+	// leaf is removed.  Returns the leaf's slot, which does not change while
+	// other leaves are inserted or removed.
+	unsigned int Insert(const std::vector<double> &magnitude, const std::vector<double> &phase);
+	unsigned int Insert();// Empty leaf, to be given data with Set()
+	void Remove(const unsigned int &slot);
+	void Clear();
+
+	// Refers the leaf to new data; call Update() or Rebuild() afterwards
+	void Set(const unsigned int &slot, const std::vector<double> &magnitude,
+		const std::vector<double> &phase);
+
+	// Call after the data referred to by one leaf changes
+	void Update(const unsigned int &slot);
+
+	// Call after the data referred to by many leaves changes
+	void Rebuild();
+
+	// Product of all leaves; empty when there are no leaves
+	const std::vector<double>& GetMagnitude() const { return nodes[1].magnitude; }
+	const std::vector<double>& GetPhase() const { return nodes[1].phase; }
+
+private:
+	struct Leaf
+	{
+		const std::vector<double> *magnitude = nullptr;
+		const std::vector<double> *phase = nullptr;
+	};
+
+	struct Node
+	{
+		std::vector<double> magnitude;
+		std::vector<double> phase;
+	};
+
+	// Heap layout:  node i has children 2i and 2i + 1, and indices at or
+	// above the leaf count refer to leaves.  Node zero is unused.
+	unsigned int leafCount;
+	std::vector<Leaf> leaves;
+	std::vector<Node> nodes;
+	std::vector<unsigned int> freeSlots;
+
+	void Grow();
+	void UpdateNode(const unsigned int &i);
+
+	const std::vector<double>& GetChildMagnitude(const unsigned int &i) const;
+	const std::vector<double>& GetChildPhase(const unsigned int &i) const;
+
+	static void Combine(const std::vector<double> &a, const std::vector<double> &b,
+		std::vector<double> &result);
+
+	static const std::vector<double> empty;
+};
+
+#endif// _RESPONSE_PRODUCT_TREE_H_
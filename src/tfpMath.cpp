@@ -16,90 +16,501 @@
 
 // Local headers
 #include "tfpMath.h"
+#include "complexVector.h"
+#include "complexKernels.h"
 
 // LibPlot2D headers
-#include <lp2d/utilities/dataset2D.h>
 #include <lp2d/utilities/math/complex.h>
-#include <lp2d/utilities/math/plotMath.h>
+
+// Standard C++ headers
+#include <cmath>
+#include <cassert>
+#include <limits>
 
 //==========================================================================
 // Namespace:		TFPMath
-// Function:		GetMagnitudeData
+// Function:		GetBodeData
 //
-// Description:		Creates a dataset containing the magnitude of the specified
-//					complex-valued vector.  Note that the x-component of the
-//					dataset will be uninitialized.
+// Description:		Computes the magnitude and unwrapped phase of the specified
+//					complex-valued vector.  Results are written directly into
+//					the output vectors, which are resized to match the input.
 //
 // Input Arguments:
-//		data	= const std::vector<LibPlot2D::Complex>&
+//		data		= const ComplexVector&
 //
 // Output Arguments:
+//		magnitude	= std::vector<double>& [dB]
+//		phase		= std::vector<double>& [deg]
+//
+// Return Value:
 //		None
 //
+//==========================================================================
+void TFPMath::GetBodeData(const ComplexVector &data,
+	std::vector<double> &magnitude, std::vector<double> &phase)
+{
+	magnitude.resize(data.GetSize());
+	phase.resize(data.GetSize());
+
+	GetBodeData(data, 0, data.GetSize(), magnitude, phase);
+	UnwrapPhase(phase);
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		GetBodeData
+//
+// Description:		Computes the magnitude and wrapped angle of the specified
+//					range of a complex-valued vector in a single pass.  This
+//					is where nearly all of the work is done, and points are
+//					independent, so ranges may be processed in parallel.
+//					Results are written to the same positions in the outputs,
+//					which must already be large enough.  The angles must be
+//					passed to UnwrapPhase() once all ranges are complete.
+//
+// Input Arguments:
+//		data		= const ComplexVector&
+//		start		= const unsigned int&, first index to process
+//		end			= const unsigned int&, one past the last index to process
+//
+// Output Arguments:
+//		magnitude	= std::vector<double>& [dB]
+//		angle		= std::vector<double>& [rad]
+//
 // Return Value:
-//		LibPlot2D::Dataset2D
+//		None
 //
 //==========================================================================
-LibPlot2D::Dataset2D TFPMath::GetMagnitudeData(const std::vector<LibPlot2D::Complex> &data)
+void TFPMath::GetBodeData(const ComplexVector &data, const unsigned int &start,
+	const unsigned int &end, std::vector<double> &magnitude, std::vector<double> &angle)
 {
-	LibPlot2D::Dataset2D result(data.size());
-	for (unsigned int i = 0; i < result.GetNumberOfPoints(); ++i)
-		result.GetY()[i] = sqrt(data[i].mReal * data[i].mReal + data[i].mImaginary * data[i].mImaginary);
+	const double *real(data.GetReal()), *imaginary(data.GetImaginary());
+	for (unsigned int i = start; i < end; ++i)
+	{
+		const double re(real[i]), im(imaginary[i]);
 
-	return result;
+		// 10 * log10(|z|^2) avoids a square root
+		magnitude[i] = 10.0 * log10(re * re + im * im);
+		angle[i] = atan2(im, re);
+	}
 }
 
 //==========================================================================
 // Namespace:		TFPMath
-// Function:		GetPhaseData
+// Function:		UnwrapPhase
 //
-// Description:		Creates a dataset containing the phase of the specified
-//					complex-valued vector.  Note that the x-component of the
-//					dataset will be uninitialized.
+// Description:		Converts wrapped angles to unwrapped phase, in place.  Each
+//					point's offset depends on all of the previous points, so
+//					this must be done in order, but it only involves a few
+//					operations per point.
 //
 // Input Arguments:
-//		data	= const std::vector<LibPlot2D::Complex>&
+//		phase	= std::vector<double>& [rad], in (-pi, pi]
 //
 // Output Arguments:
+//		phase	= std::vector<double>& [deg], unwrapped
+//
+// Return Value:
 //		None
 //
+//==========================================================================
+void TFPMath::UnwrapPhase(std::vector<double> &phase)
+{
+	double lastAngle(0.0), offset(0.0);
+	for (unsigned int i = 0; i < phase.size(); ++i)
+	{
+		const double angle(phase[i]);
+		if (i > 0)
+		{
+			if (angle - lastAngle > M_PI)
+				offset -= 2.0 * M_PI;
+			else if (angle - lastAngle < -M_PI)
+				offset += 2.0 * M_PI;
+		}
+
+		lastAngle = angle;
+		phase[i] = (angle + offset) * 180.0 / M_PI;
+	}
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Add
+//
+// Description:		Computes a = a + b element-wise.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const ComplexVector&, same size as a
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
 // Return Value:
-//		LibPlot2D::Dataset2D
+//		None
 //
 //==========================================================================
-LibPlot2D::Dataset2D TFPMath::GetPhaseData(const std::vector<LibPlot2D::Complex> &data)
+void TFPMath::Add(ComplexVector &a, const ComplexVector &b)
 {
-	LibPlot2D::Dataset2D result(data.size());
-	for (unsigned int i = 0; i < result.GetNumberOfPoints(); ++i)
-		result.GetY()[i] = atan2(data[i].mImaginary, data[i].mReal);
+	assert(a.GetSize() == b.GetSize());
+	ComplexKernels::Get().add(a.GetReal(), a.GetImaginary(),
+		b.GetReal(), b.GetImaginary(), a.GetSize());
+}
 
-	LibPlot2D::PlotMath::Unwrap(result);
-	result *= 180.0 / M_PI;
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Subtract
+//
+// Description:		Computes a = a - b element-wise.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const ComplexVector&, same size as a
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Subtract(ComplexVector &a, const ComplexVector &b)
+{
+	assert(a.GetSize() == b.GetSize());
+	ComplexKernels::Get().subtract(a.GetReal(), a.GetImaginary(),
+		b.GetReal(), b.GetImaginary(), a.GetSize());
+}
 
-	return result;
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Multiply
+//
+// Description:		Computes a = a * b element-wise.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const ComplexVector&, same size as a
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Multiply(ComplexVector &a, const ComplexVector &b)
+{
+	assert(a.GetSize() == b.GetSize());
+	ComplexKernels::Get().multiply(a.GetReal(), a.GetImaginary(),
+		b.GetReal(), b.GetImaginary(), a.GetSize());
 }
 
 //==========================================================================
 // Namespace:		TFPMath
-// Function:		ConvertToDecibels
+// Function:		Divide
 //
-// Description:		Converts the specified magnitude data to decibels.
+// Description:		Computes a = a / b element-wise.
 //
 // Input Arguments:
-//		data	= const LibPlot2D::Dataset2D&
+//		a	= ComplexVector&
+//		b	= const ComplexVector&, same size as a
 //
 // Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Divide(ComplexVector &a, const ComplexVector &b)
+{
+	assert(a.GetSize() == b.GetSize());
+	ComplexKernels::Get().divide(a.GetReal(), a.GetImaginary(),
+		b.GetReal(), b.GetImaginary(), a.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Power
+//
+// Description:		Computes a = a ^ b element-wise.  There is no packed
+//					kernel for complex exponents, so this is evaluated one
+//					element at a time.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const ComplexVector&, same size as a
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Power(ComplexVector &a, const ComplexVector &b)
+{
+	assert(a.GetSize() == b.GetSize());
+	for (unsigned int i = 0; i < a.GetSize(); ++i)
+		a.SetValue(i, a.GetValue(i).ToPower(b.GetValue(i)));
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Add
+//
+// Description:		Computes a = a + b element-wise, where b is real.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const double&
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
 //		None
 //
+//==========================================================================
+void TFPMath::Add(ComplexVector &a, const double &b)
+{
+	ComplexKernels::Get().addScalar(a.GetReal(), a.GetImaginary(), b, a.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Subtract
+//
+// Description:		Computes a = a - b element-wise, where b is real.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const double&
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
 // Return Value:
-//		LibPlot2D::Dataset2D
+//		None
 //
 //==========================================================================
-LibPlot2D::Dataset2D TFPMath::ConvertToDecibels(const LibPlot2D::Dataset2D &data)
+void TFPMath::Subtract(ComplexVector &a, const double &b)
 {
-	LibPlot2D::Dataset2D results(data);
-	for (unsigned int i = 0; i < results.GetNumberOfPoints(); ++i)
-		results.GetY()[i] = 20.0 * log10(data.GetY()[i]);
+	ComplexKernels::Get().subtractScalar(a.GetReal(), a.GetImaginary(), b, a.GetSize());
+}
 
-	return results;
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Multiply
+//
+// Description:		Computes a = a * b element-wise, where b is real.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const double&
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Multiply(ComplexVector &a, const double &b)
+{
+	ComplexKernels::Get().multiplyScalar(a.GetReal(), a.GetImaginary(), b, a.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Divide
+//
+// Description:		Computes a = a / b element-wise, where b is real.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const double&
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Divide(ComplexVector &a, const double &b)
+{
+	ComplexKernels::Get().divideScalar(a.GetReal(), a.GetImaginary(), b, a.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Power
+//
+// Description:		Computes a = a ^ b element-wise, where b is real.  Integer
+//					exponents use repeated multiplication instead of the
+//					polar form.
+//
+// Input Arguments:
+//		a	= ComplexVector&
+//		b	= const double&
+//
+// Output Arguments:
+//		a	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Power(ComplexVector &a, const double &b)
+{
+	if (b == floor(b) && fabs(b) <= std::numeric_limits<int>::max())
+	{
+		IntegerPower(a, static_cast<int>(b));
+		return;
+	}
+
+	const LibPlot2D::Complex exponent(b, 0.0);
+	for (unsigned int i = 0; i < a.GetSize(); ++i)
+		a.SetValue(i, a.GetValue(i).ToPower(exponent));
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Add
+//
+// Description:		Computes b = a + b element-wise, where a is real.
+//
+// Input Arguments:
+//		a	= const double&
+//		b	= ComplexVector&
+//
+// Output Arguments:
+//		b	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Add(const double &a, ComplexVector &b)
+{
+	ComplexKernels::Get().addScalar(b.GetReal(), b.GetImaginary(), a, b.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Subtract
+//
+// Description:		Computes b = a - b element-wise, where a is real.
+//
+// Input Arguments:
+//		a	= const double&
+//		b	= ComplexVector&
+//
+// Output Arguments:
+//		b	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Subtract(const double &a, ComplexVector &b)
+{
+	ComplexKernels::Get().scalarSubtract(b.GetReal(), b.GetImaginary(), a, b.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Multiply
+//
+// Description:		Computes b = a * b element-wise, where a is real.
+//
+// Input Arguments:
+//		a	= const double&
+//		b	= ComplexVector&
+//
+// Output Arguments:
+//		b	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Multiply(const double &a, ComplexVector &b)
+{
+	ComplexKernels::Get().multiplyScalar(b.GetReal(), b.GetImaginary(), a, b.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Divide
+//
+// Description:		Computes b = a / b element-wise, where a is real.
+//
+// Input Arguments:
+//		a	= const double&
+//		b	= ComplexVector&
+//
+// Output Arguments:
+//		b	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Divide(const double &a, ComplexVector &b)
+{
+	ComplexKernels::Get().scalarDivide(b.GetReal(), b.GetImaginary(), a, b.GetSize());
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		Power
+//
+// Description:		Computes b = a ^ b element-wise, where a is real.
+//
+// Input Arguments:
+//		a	= const double&
+//		b	= ComplexVector&
+//
+// Output Arguments:
+//		b	= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::Power(const double &a, ComplexVector &b)
+{
+	const LibPlot2D::Complex base(a, 0.0);
+	for (unsigned int i = 0; i < b.GetSize(); ++i)
+		b.SetValue(i, base.ToPower(b.GetValue(i)));
+}
+
+//==========================================================================
+// Namespace:		TFPMath
+// Function:		IntegerPower
+//
+// Description:		Computes a = a ^ power element-wise by repeated squaring.
+//					Negative powers are computed as the reciprocal of the
+//					positive power.
+//
+// Input Arguments:
+//		a		= ComplexVector&
+//		power	= const int&
+//
+// Output Arguments:
+//		a		= ComplexVector&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TFPMath::IntegerPower(ComplexVector &a, const int &power)
+{
+	const ComplexKernels::Table& kernels(ComplexKernels::Get());
+	const unsigned int magnitude(power < 0 ? 0U - static_cast<unsigned int>(power) : power);
+	kernels.integerPower(a.GetReal(), a.GetImaginary(), magnitude, a.GetSize());
+	if (power < 0)
+		kernels.scalarDivide(a.GetReal(), a.GetImaginary(), 1.0, a.GetSize());
 }
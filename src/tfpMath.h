@@ -20,68 +20,42 @@
 // Standard C++ headers
 #include <vector>
 
-// LibPlot2D forward declarations
-namespace LibPlot2D
-{
-class Dataset2D;
-class Complex;
-}
+// Local forward declarations
+class ComplexVector;
 
 namespace TFPMath
 {
-	LibPlot2D::Dataset2D GetMagnitudeData(const std::vector<LibPlot2D::Complex> &data);
-	LibPlot2D::Dataset2D GetPhaseData(const std::vector<LibPlot2D::Complex> &data);
-
-	LibPlot2D::Dataset2D ConvertToDecibels(const LibPlot2D::Dataset2D &data);
-
-	template<typename T>
-	std::vector<T> operator+(const std::vector<T>& a, const std::vector<T>& b);
-	template<typename T>
-	std::vector<T> operator-(const std::vector<T>& a, const std::vector<T>& b);
-	template<typename T>
-	std::vector<T> operator*(const std::vector<T>& a, const std::vector<T>& b);
-	template<typename T>
-	std::vector<T> operator/(const std::vector<T>& a, const std::vector<T>& b);
-}
-
-template<typename T>
-std::vector<T> TFPMath::operator+(const std::vector<T>& a, const std::vector<T>& b)
-{
-	std::vector<T> result(a.size());
-	for (unsigned int i = 0; i < result.size(); ++i)
-		result[i] = a[i] + b[i];
-
-	return result;
-}
-
-template<typename T>
-std::vector<T> TFPMath::operator-(const std::vector<T>& a, const std::vector<T>& b)
-{
-	std::vector<T> result(a.size());
-	for (unsigned int i = 0; i < result.size(); ++i)
-		result[i] = a[i] - b[i];
-
-	return result;
-}
-
-template<typename T>
-std::vector<T> TFPMath::operator*(const std::vector<T>& a, const std::vector<T>& b)
-{
-	std::vector<T> result(a.size());
-	for (unsigned int i = 0; i < result.size(); ++i)
-		result[i] = a[i] * b[i];
-
-	return result;
-}
-
-template<typename T>
-std::vector<T> TFPMath::operator/(const std::vector<T>& a, const std::vector<T>& b)
-{
-	std::vector<T> result(a.size());
-	for (unsigned int i = 0; i < result.size(); ++i)
-		result[i] = a[i] / b[i];
-
-	return result;
+	void GetBodeData(const ComplexVector &data,
+		std::vector<double> &magnitude, std::vector<double> &phase);
+
+	// For evaluating in parallel:  process ranges with the first function,
+	// then pass the angles to the second
+	void GetBodeData(const ComplexVector &data, const unsigned int &start,
+		const unsigned int &end, std::vector<double> &magnitude, std::vector<double> &angle);
+	void UnwrapPhase(std::vector<double> &phase);
+
+	// Element-wise complex arithmetic using the fastest kernels available on
+	// this processor.  Results are stored in the non-const argument.  Real
+	// arguments are treated as complex numbers with zero imaginary part.
+	void Add(ComplexVector &a, const ComplexVector &b);
+	void Subtract(ComplexVector &a, const ComplexVector &b);
+	void Multiply(ComplexVector &a, const ComplexVector &b);
+	void Divide(ComplexVector &a, const ComplexVector &b);
+	void Power(ComplexVector &a, const ComplexVector &b);
+
+	void Add(ComplexVector &a, const double &b);
+	void Subtract(ComplexVector &a, const double &b);
+	void Multiply(ComplexVector &a, const double &b);
+	void Divide(ComplexVector &a, const double &b);
+	void Power(ComplexVector &a, const double &b);
+
+	void Add(const double &a, ComplexVector &b);
+	void Subtract(const double &a, ComplexVector &b);
+	void Multiply(const double &a, ComplexVector &b);
+	void Divide(const double &a, ComplexVector &b);
+	void Power(const double &a, ComplexVector &b);
+
+	void IntegerPower(ComplexVector &a, const int &power);
 }
 
 #endif// _TFP_MATH_H_
@@ -0,0 +1,223 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  threadPool.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Fixed set of worker threads for splitting a range of indices into
+//				 chunks and processing the chunks in parallel.  The calling thread
+//				 works alongside the pool threads, so a pool with a thread count of one
+//				 runs everything on the calling thread.
+
+// Local headers
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ThreadPool
+//
+// Description:		Constructor for ThreadPool class.  Starts the worker
+//					threads.
+//
+// Input Arguments:
+//		threadCount	= const unsigned int&, including the calling thread; zero
+//					  uses one thread per hardware thread
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ThreadPool::ThreadPool(const unsigned int &threadCount) : nextChunk(0)
+{
+	const unsigned int total(threadCount == 0 ? GetHardwareThreadCount() : threadCount);
+	for (unsigned int i = 1; i < total; ++i)
+		threads.push_back(std::thread(&ThreadPool::ThreadEntry, this, i));
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		~ThreadPool
+//
+// Description:		Destructor for ThreadPool class.  Stops and joins the
+//					worker threads.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	startCondition.notify_all();
+	for (auto& thread : threads)
+		thread.join();
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		GetHardwareThreadCount
+//
+// Description:		Returns the number of threads the hardware can run
+//					concurrently.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, at least one
+//
+//==========================================================================
+unsigned int ThreadPool::GetHardwareThreadCount()
+{
+	const unsigned int count(std::thread::hardware_concurrency());
+	if (count == 0)
+		return 1;
+	return count;
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		Run
+//
+// Description:		Implements ParallelFor() without knowledge of the type of
+//					the function to call.
+//
+// Input Arguments:
+//		count			= const unsigned int&
+//		chunkSize		= const unsigned int&
+//		rangeFunction	= RangeFunction, calls function
+//		function		= const void*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::Run(const unsigned int &count, const unsigned int &chunkSize,
+	RangeFunction rangeFunction, const void *function)
+{
+	if (count == 0)
+		return;
+	else if (threads.empty() || count <= chunkSize)
+	{
+		rangeFunction(function, 0, count, 0);
+		return;
+	}
+
+	std::lock_guard<std::mutex> callLock(callMutex);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->rangeFunction = rangeFunction;
+		this->function = function;
+		this->count = count;
+		this->chunkSize = chunkSize;
+		nextChunk = 0;
+		activeThreads = static_cast<unsigned int>(threads.size());
+		++generation;
+	}
+
+	startCondition.notify_all();
+	ProcessChunks(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this]() { return activeThreads == 0; });
+	this->rangeFunction = nullptr;
+	this->function = nullptr;
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ThreadEntry
+//
+// Description:		Entry point for worker threads.  Waits for work, then
+//					processes chunks until none remain.
+//
+// Input Arguments:
+//		thread	= const unsigned int, index of this thread
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::ThreadEntry(const unsigned int thread)
+{
+	unsigned int lastGeneration(0);
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock, [this, lastGeneration]()
+			{
+				return stopping || generation != lastGeneration;
+			});
+
+			if (stopping)
+				return;
+			lastGeneration = generation;
+		}
+
+		ProcessChunks(thread);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--activeThreads == 0)
+			doneCondition.notify_one();
+	}
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ProcessChunks
+//
+// Description:		Claims and processes chunks of the current range until
+//					none remain.
+//
+// Input Arguments:
+//		thread	= const unsigned int&, index of this thread
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::ProcessChunks(const unsigned int &thread)
+{
+	const unsigned int chunkCount((count + chunkSize - 1) / chunkSize);
+	unsigned int chunk;
+	while ((chunk = nextChunk++) < chunkCount)
+	{
+		const unsigned int begin(chunk * chunkSize);
+		rangeFunction(function, begin, std::min(begin + chunkSize, count), thread);
+	}
+}
@@ -0,0 +1,138 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  threadPool.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Fixed set of worker threads for splitting a range of indices into
+//				 chunks and processing the chunks in parallel.  The calling thread
+//				 works alongside the pool threads, so a pool with a thread count of one
+//				 runs everything on the calling thread.
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+// Standard C++ headers
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class ThreadPool
+{
+public:
+	// Zero uses one thread per hardware thread
+	explicit ThreadPool(const unsigned int &threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Includes the calling thread
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(threads.size()) + 1; }
+
+	// Blocks until the whole range has been processed.  Chunks are
+	// multiples of chunkSize, except possibly the last.  The function is
+	// called with (begin, end, thread), where thread is less than
+	// GetThreadCount().  It is not copied, so calling does not allocate.
+	template <typename Function>
+	void ParallelFor(const unsigned int &count, const unsigned int &chunkSize,
+		const Function &function);
+
+	static unsigned int GetHardwareThreadCount();
+
+private:
+	std::vector<std::thread> threads;
+
+	std::mutex callMutex;// Serializes calls to ParallelFor
+
+	std::mutex mutex;
+	std::condition_variable startCondition;
+	std::condition_variable doneCondition;
+	bool stopping = false;
+	unsigned int generation = 0;
+	unsigned int activeThreads = 0;
+
+	typedef void (*RangeFunction)(const void *function, const unsigned int &begin,
+		const unsigned int &end, const unsigned int &thread);
+
+	template <typename Function>
+	static void CallFunction(const void *function, const unsigned int &begin,
+		const unsigned int &end, const unsigned int &thread);
+
+	void Run(const unsigned int &count, const unsigned int &chunkSize,
+		RangeFunction rangeFunction, const void *function);
+
+	// Describes the current call to ParallelFor
+	RangeFunction rangeFunction = nullptr;
+	const void *function = nullptr;
+	unsigned int count = 0;
+	unsigned int chunkSize = 1;
+	std::atomic<unsigned int> nextChunk;
+
+	void ThreadEntry(const unsigned int thread);
+	void ProcessChunks(const unsigned int &thread);
+};
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ParallelFor
+//
+// Description:		Calls the specified function for chunks of the range
+//					[0, count) until the whole range is covered.  Chunks are
+//					handed out in order to whichever thread is free.
+//
+// Input Arguments:
+//		count		= const unsigned int&
+//		chunkSize	= const unsigned int&
+//		function	= const Function&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <typename Function>
+void ThreadPool::ParallelFor(const unsigned int &count, const unsigned int &chunkSize,
+	const Function &function)
+{
+	Run(count, chunkSize, &CallFunction<Function>, &function);
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		CallFunction
+//
+// Description:		Restores the type of the function passed to ParallelFor
+//					and calls it.
+//
+// Input Arguments:
+//		function	= const void*, points to a Function
+//		begin		= const unsigned int&
+//		end			= const unsigned int&
+//		thread		= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <typename Function>
+void ThreadPool::CallFunction(const void *function, const unsigned int &begin,
+	const unsigned int &end, const unsigned int &thread)
+{
+	(*static_cast<const Function*>(function))(begin, end, thread);
+}
+
+#endif// _THREAD_POOL_H_
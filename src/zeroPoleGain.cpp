@@ -0,0 +1,427 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  zeroPoleGain.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Factored (zero/pole/gain) form of a transfer function.  Magnitude and
+//				 phase are computed as sums over the individual factors, which avoids
+//				 the loss of precision that comes with evaluating high-order expanded
+//				 polynomials and removes the need to unwrap the phase.
+
+// Local headers
+#include "zeroPoleGain.h"
+
+// Standard C++ headers
+#include <cmath>
+#include <limits>
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		ZeroPoleGain
+//
+// Description:		Constructor for ZeroPoleGain class.  Finds the roots of
+//					each factor of the numerator and denominator.  If any
+//					roots cannot be found, the object is flagged as invalid.
+//
+// Input Arguments:
+//		rationalFunction	= const RationalFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ZeroPoleGain::ZeroPoleGain(const RationalFunction &rationalFunction)
+{
+	double numeratorGain, denominatorGain;
+	if (!AddFactors(rationalFunction.GetNumeratorFactors(), zeros, numeratorGain) ||
+		!AddFactors(rationalFunction.GetDenominatorFactors(), poles, denominatorGain) ||
+		denominatorGain == 0.0)
+		return;
+
+	gain = numeratorGain / denominatorGain;
+	isValid = true;
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		AddFactors
+//
+// Description:		Finds the roots of each of the specified factors.  Roots of
+//					repeated factors are found once and added with the
+//					factor's power as their multiplicity, as are equal roots
+//					within a factor.
+//
+// Input Arguments:
+//		factors		= const std::vector<RationalFunction::Factor>&
+//
+// Output Arguments:
+//		roots		= std::vector<Root>&
+//		factorGain	= double&, product of leading coefficients
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool ZeroPoleGain::AddFactors(const std::vector<RationalFunction::Factor> &factors,
+	std::vector<Root> &roots, double &factorGain)
+{
+	factorGain = 1.0;
+	std::vector<std::complex<double>> factorRoots;
+	for (const auto& factor : factors)
+	{
+		double leading;
+		factorRoots.clear();
+		if (!FindRoots(factor.polynomial, factorRoots, leading))
+			return false;
+
+		factorGain *= pow(leading, factor.power);
+		const unsigned int first(static_cast<unsigned int>(roots.size()));
+		for (const auto& root : factorRoots)
+		{
+			if (roots.size() > first && roots.back().value == root)
+				roots.back().multiplicity += factor.power;
+			else
+				roots.push_back({ root, factor.power });
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		Evaluate
+//
+// Description:		Evaluates the magnitude and phase at s = j * 2 * pi * f for
+//					each specified frequency.  The magnitude products are
+//					accumulated with a separate binary exponent, so a single
+//					logarithm is required per point (plus one for each
+//					repeated root) and high-order functions do not overflow.  Each factor's angle is continuous with
+//					frequency, so the phase does not need to be unwrapped.  As
+//					with unwrapped data, the first point is in (-180, 180].
+//
+// Input Arguments:
+//		omega	= const std::vector<double>& [rad/sec]
+//
+// Output Arguments:
+//		magnitude	= std::vector<double>& [dB]
+//		phase		= std::vector<double>& [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ZeroPoleGain::Evaluate(const std::vector<double> &omega,
+	std::vector<double> &magnitude, std::vector<double> &phase) const
+{
+	magnitude.resize(omega.size());
+	phase.resize(omega.size());
+
+	Evaluate(omega, 0, omega.size(), magnitude, phase);
+	AlignPhase(phase);
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		Evaluate
+//
+// Description:		Evaluates the magnitude and phase for the specified range
+//					of frequencies.  Results are written to the same positions
+//					in the outputs, which must already be large enough.  The
+//					phase is not shifted; call AlignPhase() once the whole
+//					range has been evaluated.
+//
+// Input Arguments:
+//		omega	= const std::vector<double>& [rad/sec]
+//		start	= const unsigned int&, first index to evaluate
+//		end		= const unsigned int&, one past the last index to evaluate
+//
+// Output Arguments:
+//		magnitude	= std::vector<double>& [dB]
+//		phase		= std::vector<double>& [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ZeroPoleGain::Evaluate(const std::vector<double> &omega, const unsigned int &start,
+	const unsigned int &end, std::vector<double> &magnitude, std::vector<double> &phase) const
+{
+	const double gainDecibels(20.0 * log10(fabs(gain)));
+	const double gainAngle(gain < 0.0 ? M_PI : 0.0);
+	const double log2(log10(2.0));
+	const double rescaleLimit(1.0e150);
+
+	for (unsigned int i = start; i < end; ++i)
+	{
+		double mantissa(1.0), angle(gainAngle);
+		int exponent(0), e;
+
+		double repeated(0.0);// Sum of log10() of repeated factors' squared magnitudes
+
+		for (const auto& z : zeros)
+		{
+			const double imaginary(omega[i] - z.value.imag());
+			const double square(z.value.real() * z.value.real() + imaginary * imaginary);
+			if (z.multiplicity > 1)
+			{
+				repeated += z.multiplicity * log10(square);
+				angle += z.multiplicity * GetFactorAngle(z.value, omega[i]);
+				continue;
+			}
+
+			mantissa *= square;
+			angle += GetFactorAngle(z.value, omega[i]);
+			if (mantissa > rescaleLimit || mantissa < 1.0 / rescaleLimit)
+			{
+				mantissa = frexp(mantissa, &e);
+				exponent += e;
+			}
+		}
+
+		for (const auto& p : poles)
+		{
+			const double imaginary(omega[i] - p.value.imag());
+			const double square(p.value.real() * p.value.real() + imaginary * imaginary);
+			if (p.multiplicity > 1)
+			{
+				repeated -= p.multiplicity * log10(square);
+				angle -= p.multiplicity * GetFactorAngle(p.value, omega[i]);
+				continue;
+			}
+
+			mantissa /= square;
+			angle -= GetFactorAngle(p.value, omega[i]);
+			if (mantissa > rescaleLimit || mantissa < 1.0 / rescaleLimit)
+			{
+				mantissa = frexp(mantissa, &e);
+				exponent += e;
+			}
+		}
+
+		// Magnitudes were accumulated as squares, so 10 * log10() gives dB
+		magnitude[i] = gainDecibels + 10.0 * (log10(mantissa) + exponent * log2 + repeated);
+		phase[i] = angle * 180.0 / M_PI;
+	}
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		AlignPhase
+//
+// Description:		Shifts the phase by a multiple of 360 deg so the first
+//					point is in (-180, 180].
+//
+// Input Arguments:
+//		phase	= std::vector<double>& [deg]
+//
+// Output Arguments:
+//		phase	= std::vector<double>& [deg]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ZeroPoleGain::AlignPhase(std::vector<double> &phase)
+{
+	if (phase.empty())
+		return;
+
+	const double shift(360.0 * ceil((phase.front() - 180.0) / 360.0));
+	if (shift != 0.0)
+	{
+		for (auto& p : phase)
+			p -= shift;
+	}
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		GetFactorAngle
+//
+// Description:		Returns the angle of (j * omega - root).  The real part of
+//					this factor does not depend on frequency, so by choosing
+//					the branch based on its sign, the result is continuous
+//					with respect to omega.
+//
+// Input Arguments:
+//		root	= const std::complex<double>&
+//		omega	= const double& [rad/sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double [rad]
+//
+//==========================================================================
+double ZeroPoleGain::GetFactorAngle(const std::complex<double> &root, const double &omega)
+{
+	if (root.real() <= 0.0)
+		return atan2(omega - root.imag(), -root.real());
+	return M_PI - atan2(omega - root.imag(), root.real());
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		FindRoots
+//
+// Description:		Finds the roots of the specified polynomial.  First- and
+//					second-order polynomials are solved directly, roots at
+//					the origin are removed and higher-order polynomials are
+//					solved iteratively.
+//
+// Input Arguments:
+//		polynomial	= const Polynomial&
+//
+// Output Arguments:
+//		roots		= std::vector<std::complex<double>>& (roots are appended)
+//		gain		= double&, the leading coefficient
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool ZeroPoleGain::FindRoots(const Polynomial &polynomial,
+	std::vector<std::complex<double>> &roots, double &gain)
+{
+	const std::vector<double>& allCoefficients(polynomial.GetCoefficients());
+	if (allCoefficients.empty() || allCoefficients.back() == 0.0)
+	{
+		gain = 0.0;
+		return true;
+	}
+
+	gain = allCoefficients.back();
+	unsigned int start(0);
+	while (allCoefficients[start] == 0.0)
+	{
+		roots.push_back(0.0);
+		++start;
+	}
+
+	const std::vector<double> c(allCoefficients.begin() + start, allCoefficients.end());
+	if (c.size() == 1)
+		return true;
+	else if (c.size() == 2)
+	{
+		roots.push_back(-c[0] / c[1]);
+		return true;
+	}
+	else if (c.size() == 3)
+	{
+		const double discriminant(c[1] * c[1] - 4.0 * c[2] * c[0]);
+		if (discriminant >= 0.0)
+		{
+			// Avoids cancellation when b^2 >> 4ac
+			const double q(-0.5 * (c[1] + copysign(sqrt(discriminant), c[1])));
+			roots.push_back(q / c[2]);
+			roots.push_back(c[0] / q);
+		}
+		else
+		{
+			const double real(-0.5 * c[1] / c[2]);
+			const double imaginary(0.5 * sqrt(-discriminant) / fabs(c[2]));
+			roots.push_back(std::complex<double>(real, imaginary));
+			roots.push_back(std::complex<double>(real, -imaginary));
+		}
+
+		return true;
+	}
+
+	return FindRootsAberth(c, roots);
+}
+
+//==========================================================================
+// Class:			ZeroPoleGain
+// Function:		FindRootsAberth
+//
+// Description:		Finds the roots of the specified polynomial using the
+//					Aberth-Ehrlich method.  A root is considered converged
+//					when the residual is within the rounding error of the
+//					polynomial evaluation.  The constant coefficient must be
+//					non-zero.
+//
+// Input Arguments:
+//		coefficients	= const std::vector<double>&
+//
+// Output Arguments:
+//		roots			= std::vector<std::complex<double>>& (roots are appended)
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool ZeroPoleGain::FindRootsAberth(const std::vector<double> &coefficients,
+	std::vector<std::complex<double>> &roots)
+{
+	const unsigned int order(coefficients.size() - 1);
+	std::vector<double> a(coefficients.size());
+	for (unsigned int i = 0; i < a.size(); ++i)
+		a[i] = coefficients[i] / coefficients.back();
+
+	// Start on a circle with radius equal to the geometric mean of the root magnitudes
+	const double radius(pow(fabs(a.front()), 1.0 / order));
+	std::vector<std::complex<double>> z(order);
+	for (unsigned int i = 0; i < order; ++i)
+		z[i] = std::polar(radius, 2.0 * M_PI * i / order + 0.5);
+
+	const unsigned int maxIterations(500);
+	const double tolerance(8.0 * std::numeric_limits<double>::epsilon() * order);
+	std::vector<bool> converged(order, false);
+	unsigned int convergedCount(0);
+
+	for (unsigned int iteration = 0; iteration < maxIterations && convergedCount < order; ++iteration)
+	{
+		for (unsigned int i = 0; i < order; ++i)
+		{
+			if (converged[i])
+				continue;
+
+			std::complex<double> p(1.0), dp(0.0);
+			double bound(1.0);
+			const double magnitude(std::abs(z[i]));
+			for (int j = order - 1; j >= 0; --j)
+			{
+				dp = dp * z[i] + p;
+				p = p * z[i] + a[j];
+				bound = bound * magnitude + fabs(a[j]);
+			}
+
+			if (std::abs(p) <= tolerance * bound)
+			{
+				converged[i] = true;
+				++convergedCount;
+				continue;
+			}
+
+			const std::complex<double> ratio(p / dp);
+			std::complex<double> sum(0.0);
+			for (unsigned int j = 0; j < order; ++j)
+			{
+				if (j != i)
+					sum += 1.0 / (z[i] - z[j]);
+			}
+
+			z[i] -= ratio / (1.0 - ratio * sum);
+			if (!std::isfinite(z[i].real()) || !std::isfinite(z[i].imag()))
+				return false;
+		}
+	}
+
+	if (convergedCount < order)
+		return false;
+
+	roots.insert(roots.end(), z.begin(), z.end());
+	return true;
+}
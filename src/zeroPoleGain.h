@@ -0,0 +1,69 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  zeroPoleGain.h
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Factored (zero/pole/gain) form of a transfer function.  Magnitude and
+//				 phase are computed as sums over the individual factors, which avoids
+//				 the loss of precision that comes with evaluating high-order expanded
+//				 polynomials and removes the need to unwrap the phase.
+
+#ifndef _ZERO_POLE_GAIN_H_
+#define _ZERO_POLE_GAIN_H_
+
+// Local headers
+#include "rationalFunction.h"
+
+// Standard C++ headers
+#include <vector>
+#include <complex>
+
+class ZeroPoleGain
+{
+public:
+	ZeroPoleGain() = default;
+	explicit ZeroPoleGain(const RationalFunction &rationalFunction);
+
+	// False if roots could not be found
+	bool IsValid() const { return isValid; }
+
+	// Angular frequencies are in [rad/sec], magnitude is in [dB] and phase is in [deg]
+	void Evaluate(const std::vector<double> &omega, std::vector<double> &magnitude,
+		std::vector<double> &phase) const;
+
+	// Evaluates [start, end) into outputs that are already sized; the phase
+	// must be passed to AlignPhase() once all ranges are complete
+	void Evaluate(const std::vector<double> &omega, const unsigned int &start,
+		const unsigned int &end, std::vector<double> &magnitude, std::vector<double> &phase) const;
+	static void AlignPhase(std::vector<double> &phase);
+
+	static bool FindRoots(const Polynomial &polynomial, std::vector<std::complex<double>> &roots, double &gain);
+
+private:
+	bool isValid = false;
+
+	// Repeated roots are stored once, so each is evaluated once per point
+	struct Root
+	{
+		std::complex<double> value;
+		unsigned int multiplicity;
+	};
+
+	double gain = 0.0;
+	std::vector<Root> zeros;
+	std::vector<Root> poles;
+
+	static bool AddFactors(const std::vector<RationalFunction::Factor> &factors, std::vector<Root> &roots, double &factorGain);
+
+	static bool FindRootsAberth(const std::vector<double> &coefficients, std::vector<std::complex<double>> &roots);
+	static double GetFactorAngle(const std::complex<double> &root, const double &omega);
+};
+
+#endif// _ZERO_POLE_GAIN_H_
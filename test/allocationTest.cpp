@@ -0,0 +1,133 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  allocationTest.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Checks that once a solver has been used, solving again on a grid of
+//				 the same size does not allocate.  Every call to operator new is
+//				 counted, on every thread.
+
+// Local headers
+#include "expressionTree.h"
+#include "frequencyGrid.h"
+
+// Standard C++ headers
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace
+{
+
+std::atomic<unsigned long> allocationCount(0);
+
+}
+
+void* operator new(std::size_t size)
+{
+	++allocationCount;
+	if (void *p = std::malloc(size > 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		CheckSolve
+//
+// Description:		Solves the expression twice on one grid, and then once
+//					with several other programs, and reports any allocations
+//					made by the second solve of each kind.
+//
+// Input Arguments:
+//		expression	= const wxString&
+//		threads		= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the second solves did not allocate
+//
+//==========================================================================
+bool CheckSolve(const wxString &expression, const unsigned int &threads)
+{
+	ExpressionTree solver;
+	solver.SetThreadCount(threads);
+
+	CompiledExpression program;
+	const wxString errorString(solver.Compile(expression, program));
+	if (!errorString.IsEmpty())
+	{
+		printf("FAIL %s: %s\n", expression.ToStdString().c_str(),
+			errorString.ToStdString().c_str());
+		return false;
+	}
+
+	const FrequencyGrid grid(0.01, 100.0, 20000);
+	const FrequencyGrid smallGrid(0.1, 10.0, 300);
+	std::vector<double> magnitude, phase;
+	std::vector<double> smallMagnitude, smallPhase;
+	const std::vector<ExpressionTree::SolveTask> tasks({
+		{ &program, &grid, &magnitude, &phase },
+		{ &program, &smallGrid, &smallMagnitude, &smallPhase } });
+
+	solver.Solve(program, grid, magnitude, phase);
+	unsigned long start(allocationCount);
+	solver.Solve(program, grid, magnitude, phase);
+	const unsigned long singleAllocations(allocationCount - start);
+
+	solver.Solve(tasks);
+	start = allocationCount;
+	solver.Solve(tasks);
+	const unsigned long taskAllocations(allocationCount - start);
+
+	const bool passed(singleAllocations == 0 && taskAllocations == 0);
+	printf("%s %s, %u thread(s): %lu allocations for one program, %lu for several\n",
+		passed ? "pass" : "FAIL", expression.ToStdString().c_str(),
+		threads, singleAllocations, taskAllocations);
+	return passed;
+}
+
+}
+
+int main()
+{
+	// Factored, rational without roots and step program forms
+	const wxString expressions[] = {
+		_T("(s^2+2*0.1*10*s+100)/((s+1)*(s^3+4*s^2+5*s+6))"),
+		_T("(s+1)^3/(s^2+s+1)"),
+		_T("(s^0.5+1)*(s^2+2*0.7*10*s+100)/((s^1.5+3*s+2)*(s^0.7+5))"),
+		_T("s^0.5+s^3-s^4") };
+
+	bool passed(true);
+	for (const auto& expression : expressions)
+	{
+		passed = CheckSolve(expression, 1) && passed;
+		passed = CheckSolve(expression, 4) && passed;
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/*===================================================================================
+                                TransferFunctionPlotter
+                              Copyright Kerry R. Loux 2020
+
+     No requirement for distribution of wxWidgets libraries, source, or binaries.
+                             (http://www.wxwidgets.org/)
+
+===================================================================================*/
+
+// File:  threadingTest.cpp
+// Created:  10/17/2026
+// Author:  K. Loux
+// Description:  Checks that solving on several threads gives results that are bit for
+//				 bit identical to solving on one, both for single programs and for
+//				 several programs whose chunks are shared among the threads.
+
+// Local headers
+#include "expressionTree.h"
+#include "frequencyGrid.h"
+
+// Standard C++ headers
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+struct Output
+{
+	std::vector<double> magnitude;
+	std::vector<double> phase;
+};
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		IsIdentical
+//
+// Description:		Compares the bits of two outputs, so NaN and signed zeros
+//					must also match.
+//
+// Input Arguments:
+//		a	= const Output&
+//		b	= const Output&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool IsIdentical(const Output &a, const Output &b)
+{
+	return a.magnitude.size() == b.magnitude.size() && a.phase.size() == b.phase.size() &&
+		memcmp(a.magnitude.data(), b.magnitude.data(), a.magnitude.size() * sizeof(double)) == 0 &&
+		memcmp(a.phase.data(), b.phase.data(), a.phase.size() * sizeof(double)) == 0;
+}
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		SolveEach
+//
+// Description:		Solves each program on its grid, one at a time.
+//
+// Input Arguments:
+//		programs	= const std::vector<CompiledExpression>&
+//		grids		= const std::vector<const FrequencyGrid*>&
+//		threads		= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<Output>, one per program
+//
+//==========================================================================
+std::vector<Output> SolveEach(const std::vector<CompiledExpression> &programs,
+	const std::vector<const FrequencyGrid*> &grids, const unsigned int &threads)
+{
+	ExpressionTree solver;
+	solver.SetThreadCount(threads);
+
+	std::vector<Output> outputs(programs.size());
+	for (unsigned int i = 0; i < programs.size(); ++i)
+		solver.Solve(programs[i], *grids[i], outputs[i].magnitude, outputs[i].phase);
+
+	return outputs;
+}
+
+//==========================================================================
+// Namespace:		(anonymous)
+// Function:		SolveTogether
+//
+// Description:		Solves every program on its grid in one call.
+//
+// Input Arguments:
+//		programs	= const std::vector<CompiledExpression>&
+//		grids		= const std::vector<const FrequencyGrid*>&
+//		threads		= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<Output>, one per program
+//
+//==========================================================================
+std::vector<Output> SolveTogether(const std::vector<CompiledExpression> &programs,
+	const std::vector<const FrequencyGrid*> &grids, const unsigned int &threads)
+{
+	ExpressionTree solver;
+	solver.SetThreadCount(threads);
+
+	std::vector<Output> outputs(programs.size());
+	std::vector<ExpressionTree::SolveTask> tasks;
+	for (unsigned int i = 0; i < programs.size(); ++i)
+		tasks.push_back({ &programs[i], grids[i], &outputs[i].magnitude, &outputs[i].phase });
+	solver.Solve(tasks);
+
+	return outputs;
+}
+
+}
+
+int main()
+{
+	// Factored, rational without roots and step program forms
+	const wxString expressions[] = {
+		_T("(s^2+2*0.1*10*s+100)/((s+1)*(s^3+4*s^2+5*s+6))"),
+		_T("(s+1)^3/(s^2+s+1)"),
+		_T("(s^0.5+1)*(s^2+2*0.7*10*s+100)/((s^1.5+3*s+2)*(s^0.7+5))"),
+		_T("s^0.5+s^3-s^4"),
+		_T("1/(s^2+0.01*s+100)") };
+
+	ExpressionTree compiler;
+	std::vector<CompiledExpression> programs(sizeof(expressions) / sizeof(expressions[0]));
+	for (unsigned int i = 0; i < programs.size(); ++i)
+	{
+		const wxString errorString(compiler.Compile(expressions[i], programs[i]));
+		if (!errorString.IsEmpty())
+		{
+			printf("FAIL %s: %s\n", expressions[i].ToStdString().c_str(),
+				errorString.ToStdString().c_str());
+			return 1;
+		}
+	}
+
+	// Sizes that do not divide evenly into chunks, including ones smaller
+	// than a single chunk
+	const FrequencyGrid large(0.01, 100.0, 100003);
+	const FrequencyGrid medium(0.1, 1000.0, 5001);
+	const FrequencyGrid small(1.0, 10.0, 37);
+	const std::vector<const FrequencyGrid*> grids({ &large, &medium, &small, &large, &medium });
+
+	const std::vector<Output> reference(SolveEach(programs, grids, 1));
+	const unsigned int threadCounts[] = { 1, 2, 3, 8 };
+
+	bool passed(true);
+	for (const auto& threads : threadCounts)
+	{
+		const std::vector<Output> each(SolveEach(programs, grids, threads));
+		const std::vector<Output> together(SolveTogether(programs, grids, threads));
+		for (unsigned int i = 0; i < programs.size(); ++i)
+		{
+			const bool eachPassed(IsIdentical(reference[i], each[i]));
+			const bool togetherPassed(IsIdentical(reference[i], together[i]));
+			printf("%s %s, %u thread(s), %u points: %s one at a time, %s together\n",
+				eachPassed && togetherPassed ? "pass" : "FAIL", expressions[i].ToStdString().c_str(),
+				threads, grids[i]->GetSize(), eachPassed ? "identical" : "DIFFERENT",
+				togetherPassed ? "identical" : "DIFFERENT");
+			passed = eachPassed && togetherPassed && passed;
+		}
+	}
+
+	return passed ? 0 : 1;
+}